@@ -0,0 +1,226 @@
+#include "Benchmark.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+
+namespace Benchmark
+{
+    Record::Record(std::string_view benchmark)
+    {
+        field("benchmark", benchmark);
+    }
+
+    Record& Record::field(std::string_view name, uint64_t value)
+    {
+        key(name);
+        line += std::to_string(value);
+        return *this;
+    }
+
+    Record& Record::field(std::string_view name, double value)
+    {
+        key(name);
+        if(!std::isfinite(value))
+        {
+            line += "null";
+            return *this;
+        }
+
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.6g", value);
+        line += text;
+        return *this;
+    }
+
+    Record& Record::field(std::string_view name, std::string_view value)
+    {
+        key(name);
+        line += '"';
+        for(char c : value)
+        {
+            if(c == '"' || c == '\\')
+            {
+                line += '\\';
+                line += c;
+            }
+            else if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                line += escaped;
+            }
+            else
+            {
+                line += c;
+            }
+        }
+        line += '"';
+        return *this;
+    }
+
+    void Record::emit() const
+    {
+        std::printf("%s}\n", line.c_str());
+        std::fflush(stdout);
+    }
+
+    void Record::key(std::string_view name)
+    {
+        line += line.empty() ? "{\"" : ",\"";
+        line += name;
+        line += "\":";
+    }
+
+    void Samples::reserve(size_t count)
+    {
+        values.reserve(count);
+    }
+
+    void Samples::add(Clock::duration elapsed)
+    {
+        values.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        sorted = false;
+    }
+
+    void Samples::merge(Samples const & other)
+    {
+        values.insert(values.end(), other.values.begin(), other.values.end());
+        sorted = false;
+    }
+
+    size_t Samples::count() const noexcept
+    {
+        return values.size();
+    }
+
+    void Samples::report(Record& record, std::string_view prefix)
+    {
+        if(!sorted)
+        {
+            std::sort(values.begin(), values.end());
+            sorted = true;
+        }
+
+        std::string name(prefix);
+        auto put = [&](std::string_view suffix, uint64_t value)
+        {
+            name.resize(prefix.size());
+            name += suffix;
+            record.field(name, value);
+        };
+
+        uint64_t sum = std::accumulate(values.begin(), values.end(), uint64_t(0));
+        put("min_ns", values.empty() ? 0 : values.front());
+        put("mean_ns", values.empty() ? 0 : sum / values.size());
+        put("p50_ns", percentile(0.50));
+        put("p90_ns", percentile(0.90));
+        put("p99_ns", percentile(0.99));
+        put("p999_ns", percentile(0.999));
+        put("max_ns", values.empty() ? 0 : values.back());
+    }
+
+    uint64_t Samples::percentile(double q) const noexcept
+    {
+        if(values.empty()) return 0;
+
+        // Nearest rank.
+        size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(values.size())));
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    }
+
+    double seconds(Clock::duration elapsed) noexcept
+    {
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+    Endpoint loopback(uint16_t port) noexcept
+    {
+        return Endpoint::ipv4(0x7F000001, port);
+    }
+
+    uint16_t listenLoopback(TcpSocket& listener, int backlog)
+    {
+        listener.listen(0, backlog);
+        return listener.localPort();
+    }
+
+    TcpSocket connectLoopback(uint16_t port)
+    {
+        TcpSocket socket;
+        if(!socket.connect(loopback(port), 5000)) throw std::runtime_error("connect to loopback failed");
+        return socket;
+    }
+
+    TcpSocket acceptOne(TcpSocket& listener)
+    {
+        while(true)
+        {
+            if(!listener.waitRead(5000)) throw std::runtime_error("accept timed out");
+            if(std::optional<TcpSocket> socket = listener.accept()) return std::move(*socket);
+        }
+    }
+
+    bool sendAll(TcpSocket& socket, void const * data, size_t size) noexcept
+    {
+        auto bytes = static_cast<std::byte const *>(data);
+        while(size > 0)
+        {
+            Result res = socket.send(bytes, size);
+            if(res.type == ResultType::Data)
+            {
+                bytes += res.bytes;
+                size -= res.bytes;
+            }
+            else if(res.type == ResultType::WouldBlock)
+            {
+                socket.waitWrite(-1);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool recvAll(TcpSocket& socket, void * data, size_t size) noexcept
+    {
+        auto bytes = static_cast<std::byte*>(data);
+        while(size > 0)
+        {
+            Result res = socket.recv(bytes, size);
+            if(res.type == ResultType::Data)
+            {
+                bytes += res.bytes;
+                size -= res.bytes;
+            }
+            else if(res.type == ResultType::WouldBlock)
+            {
+                socket.waitRead(-1);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t raiseFileLimit() noexcept
+    {
+        rlimit limit;
+        if(::getrlimit(RLIMIT_NOFILE, &limit) < 0) return 0;
+
+        if(limit.rlim_cur < limit.rlim_max)
+        {
+            limit.rlim_cur = limit.rlim_max;
+            if(::setrlimit(RLIMIT_NOFILE, &limit) < 0) ::getrlimit(RLIMIT_NOFILE, &limit);
+        }
+        return static_cast<size_t>(limit.rlim_cur);
+    }
+}
\ No newline at end of file
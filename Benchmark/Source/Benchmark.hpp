@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Network.hpp>
+
+namespace Benchmark
+{
+    using namespace Library::Network;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::chrono::milliseconds duration{1000};   // measured time per case, after warmup
+        std::string filter;                         // run cases whose name contains this
+    };
+
+    // One result as a single-line JSON object on stdout, so runs can be appended to a
+    // file and compared across releases with jq or a spreadsheet.
+    class Record
+    {
+    public:
+        explicit Record(std::string_view benchmark);
+
+        Record& field(std::string_view key, uint64_t value);
+        Record& field(std::string_view key, double value);
+        Record& field(std::string_view key, std::string_view value);
+
+        void emit() const;
+
+    private:
+        void key(std::string_view name);
+
+        std::string line;
+    };
+
+    // Individual latency samples; percentiles are exact, not bucketed.
+    class Samples
+    {
+    public:
+        void reserve(size_t count);
+        void add(Clock::duration elapsed);
+        void merge(Samples const & other);
+
+        size_t count() const noexcept;
+
+        // Adds min/mean/p50/p90/p99/p999/max in nanoseconds under the given prefix.
+        void report(Record& record, std::string_view prefix);
+
+    private:
+        uint64_t percentile(double q) const noexcept;
+
+        std::vector<uint64_t> values;
+        bool sorted = false;
+    };
+
+    // A thread whose exception is handed back to join() instead of terminating.
+    class Worker
+    {
+    public:
+        template<typename Body>
+        explicit Worker(Body body) :
+            thread([this, body = std::move(body)]() mutable
+            {
+                try
+                {
+                    body();
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+            })
+        {
+        }
+
+        ~Worker() noexcept
+        {
+            if(thread.joinable()) thread.join();
+        }
+
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        void join()
+        {
+            if(thread.joinable()) thread.join();
+            if(error) std::rethrow_exception(std::exchange(error, nullptr));
+        }
+
+    private:
+        std::exception_ptr error;
+        std::thread thread;
+    };
+
+    struct Case
+    {
+        char const * name;
+        void (*run)(Options const & options);
+    };
+
+    double seconds(Clock::duration elapsed) noexcept;
+
+    Endpoint loopback(uint16_t port) noexcept;
+
+    // Listens on an ephemeral port and returns it.
+    uint16_t listenLoopback(TcpSocket& listener, int backlog = 1024);
+    TcpSocket connectLoopback(uint16_t port);
+    TcpSocket acceptOne(TcpSocket& listener);
+
+    // Blocking helpers over the non-blocking sockets; false when the peer went away.
+    bool sendAll(TcpSocket& socket, void const * data, size_t size) noexcept;
+    bool recvAll(TcpSocket& socket, void * data, size_t size) noexcept;
+
+    // Raises the descriptor limit to the hard limit and returns the new soft limit.
+    size_t raiseFileLimit() noexcept;
+
+    void tcpPingPong(Options const & options);
+    void tcpStream(Options const & options);
+    void tcpAccept(Options const & options);
+    void tcpFanIn(Options const & options);
+    void udpPackets(Options const & options);
+    void udpReliable(Options const & options);
+    void eventTimers(Options const & options);
+}
\ No newline at end of file
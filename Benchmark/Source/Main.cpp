@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+
+#include <sys/utsname.h>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+
+#if !defined(BENCHMARK_REVISION)
+#define BENCHMARK_REVISION "unknown"
+#endif
+
+namespace
+{
+    using namespace Benchmark;
+
+    constexpr Case Cases[] =
+    {
+        {"tcp_pingpong", tcpPingPong},
+        {"tcp_stream", tcpStream},
+        {"tcp_accept", tcpAccept},
+        {"tcp_fanin", tcpFanIn},
+        {"udp_pps", udpPackets},
+        {"udp_reliable", udpReliable},
+        {"event_timers", eventTimers}
+    };
+
+    void usage(char const * program)
+    {
+        std::fprintf(stderr,
+            "usage: %s [--duration-ms N] [--filter NAME] [--list]\n"
+            "Runs the loopback benchmarks and prints one JSON object per result.\n", program);
+    }
+
+    void environment(Options const & options)
+    {
+        utsname system{};
+        ::uname(&system);
+
+        Record("environment")
+            .field("revision", std::string_view(BENCHMARK_REVISION))
+            .field("compiler", std::string_view(__VERSION__))
+            .field("kernel", std::string_view(system.release))
+            .field("machine", std::string_view(system.machine))
+            .field("cpus", uint64_t(std::thread::hardware_concurrency()))
+            .field("time", uint64_t(std::time(nullptr)))
+            .field("duration_ms", uint64_t(options.duration.count()))
+            .emit();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--duration-ms") == 0 && i + 1 < argc)
+        {
+            options.duration = std::chrono::milliseconds(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if(std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--list") == 0)
+        {
+            for(Case const & entry : Cases) std::printf("%s\n", entry.name);
+            return 0;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Sockets send without MSG_NOSIGNAL; a peer closing mid-send must not kill the run.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    environment(options);
+
+    int status = 0;
+    for(Case const & entry : Cases)
+    {
+        if(!options.filter.empty() && std::strstr(entry.name, options.filter.c_str()) == nullptr) continue;
+
+        try
+        {
+            entry.run(options);
+        }
+        catch(std::exception const & e)
+        {
+            Record(entry.name).field("error", std::string_view(e.what())).emit();
+            status = 1;
+        }
+    }
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "Benchmark.hpp"
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // Echoes until the peer disconnects.
+        void echo(TcpSocket& peer, size_t bufferSize)
+        {
+            std::vector<std::byte> buffer(bufferSize);
+            while(true)
+            {
+                Result res = peer.recv(buffer.data(), buffer.size());
+                if(res.type == ResultType::WouldBlock)
+                {
+                    peer.waitRead(-1);
+                    continue;
+                }
+                if(res.type != ResultType::Data) return;
+                if(!sendAll(peer, buffer.data(), res.bytes)) return;
+            }
+        }
+
+        // With a zero linger time close() resets the connection instead of leaving it in
+        // TIME_WAIT, so tens of thousands of short connections don't exhaust the ports.
+        void resetOnClose(TcpSocket& socket) noexcept
+        {
+            linger option{1, 0};
+            ::setsockopt(socket.native(), SOL_SOCKET, SO_LINGER, &option, sizeof(option));
+        }
+
+        struct Connection
+        {
+            TcpSocket socket;
+            std::byte buffer[4096];
+        };
+
+        void serveEcho(TcpSocket accepted, EventLoop& loop)
+        {
+            auto connection = std::make_shared<Connection>(std::move(accepted));
+            SocketFD fd = connection->socket.native();
+            loop.add(fd, Event::Read, [connection, fd, &loop](Event)
+            {
+                while(true)
+                {
+                    Result res = connection->socket.recv(connection->buffer, sizeof(connection->buffer));
+                    if(res.type == ResultType::WouldBlock) return;
+                    if(res.type != ResultType::Data || !sendAll(connection->socket, connection->buffer, res.bytes))
+                    {
+                        loop.remove(fd);
+                        return;
+                    }
+                }
+            });
+        }
+    }
+
+    void tcpPingPong(Options const & options)
+    {
+        for(size_t size : {size_t(1), size_t(64), size_t(1024), size_t(16384)})
+        {
+            TcpSocket listener;
+            uint16_t port = listenLoopback(listener);
+
+            Worker server([&]
+            {
+                TcpSocket peer = acceptOne(listener);
+                echo(peer, 64 * 1024);
+            });
+
+            TcpSocket client = connectLoopback(port);
+            std::vector<std::byte> message(size, std::byte{0x5A});
+            std::vector<std::byte> reply(size);
+
+            auto roundTrip = [&]
+            {
+                if(!sendAll(client, message.data(), size) || !recvAll(client, reply.data(), size))
+                {
+                    throw std::runtime_error("echo peer went away");
+                }
+            };
+
+            Clock::time_point warm = Clock::now() + options.duration / 10;
+            while(Clock::now() < warm) roundTrip();
+
+            Samples samples;
+            samples.reserve(1 << 20);
+
+            Clock::time_point start = Clock::now();
+            Clock::time_point end = start + options.duration;
+            Clock::time_point now = start;
+            while(now < end)
+            {
+                Clock::time_point before = now;
+                roundTrip();
+                now = Clock::now();
+                samples.add(now - before);
+            }
+            double elapsed = seconds(now - start);
+
+            client.shutdown();
+            server.join();
+
+            Record record("tcp_pingpong");
+            record.field("size", uint64_t(size))
+                  .field("round_trips", uint64_t(samples.count()))
+                  .field("seconds", elapsed)
+                  .field("round_trips_per_s", static_cast<double>(samples.count()) / elapsed);
+            samples.report(record, "rtt_");
+            record.emit();
+        }
+    }
+
+    void tcpStream(Options const & options)
+    {
+        for(size_t size : {size_t(1024), size_t(4096), size_t(16384), size_t(65536), size_t(262144)})
+        {
+            TcpSocket listener;
+            uint16_t port = listenLoopback(listener);
+
+            uint64_t received = 0;
+            uint64_t recvCalls = 0;
+            Clock::time_point finished;
+
+            Worker receiver([&]
+            {
+                TcpSocket peer = acceptOne(listener);
+                std::vector<std::byte> buffer(size);
+                while(true)
+                {
+                    Result res = peer.recv(buffer.data(), buffer.size());
+                    if(res.type == ResultType::WouldBlock)
+                    {
+                        peer.waitRead(-1);
+                        continue;
+                    }
+                    if(res.type != ResultType::Data) break;
+
+                    received += res.bytes;
+                    ++recvCalls;
+                }
+                finished = Clock::now();
+            });
+
+            TcpSocket sender = connectLoopback(port);
+            std::vector<std::byte> buffer(size, std::byte{0x5A});
+
+            uint64_t sent = 0;
+            uint64_t sendCalls = 0;
+            Clock::time_point start = Clock::now();
+            Clock::time_point end = start + options.duration;
+            while(Clock::now() < end)
+            {
+                Result res = sender.send(buffer.data(), buffer.size());
+                if(res.type == ResultType::WouldBlock)
+                {
+                    sender.waitWrite(-1);
+                    continue;
+                }
+                if(res.type != ResultType::Data) throw std::runtime_error("stream receiver went away");
+
+                sent += res.bytes;
+                ++sendCalls;
+            }
+
+            sender.shutdown();
+            receiver.join();
+
+            if(received != sent) throw std::runtime_error("stream lost bytes");
+
+            double elapsed = seconds(finished - start);
+            Record("tcp_stream")
+                .field("buffer", uint64_t(size))
+                .field("bytes", received)
+                .field("seconds", elapsed)
+                .field("mib_per_s", static_cast<double>(received) / elapsed / (1024.0 * 1024.0))
+                .field("gbit_per_s", static_cast<double>(received) * 8.0 / elapsed / 1e9)
+                .field("send_calls", sendCalls)
+                .field("recv_calls", recvCalls)
+                .emit();
+        }
+    }
+
+    void tcpAccept(Options const & options)
+    {
+        for(size_t clients : {size_t(1), size_t(4)})
+        {
+            TcpSocket listener;
+            uint16_t port = listenLoopback(listener);
+            if(!listener.setNonBlocking(true)) throw std::runtime_error("fcntl failed");
+
+            std::atomic<size_t> running{clients};
+            std::vector<Samples> latencies(clients);
+            std::vector<std::unique_ptr<Worker>> workers;
+
+            Clock::time_point start = Clock::now();
+            Clock::time_point end = start + options.duration;
+            for(size_t i = 0; i < clients; ++i)
+            {
+                workers.push_back(std::make_unique<Worker>([&, &samples = latencies[i]]
+                {
+                    struct Finish
+                    {
+                        std::atomic<size_t>& running;
+                        ~Finish() { --running; }
+                    } finish{running};
+
+                    samples.reserve(1 << 16);
+                    while(Clock::now() < end)
+                    {
+                        // Measured until the byte the server writes after accepting arrives.
+                        Clock::time_point before = Clock::now();
+                        TcpSocket client;
+                        if(!client.connect(loopback(port), 5000)) throw std::runtime_error("connect to loopback failed");
+
+                        std::byte byte;
+                        if(!recvAll(client, &byte, 1)) throw std::runtime_error("accept benchmark server went away");
+                        samples.add(Clock::now() - before);
+                        resetOnClose(client);
+                    }
+                }));
+            }
+
+            uint64_t accepted = 0;
+            while(running > 0)
+            {
+                if(!listener.waitRead(10)) continue;
+                while(std::optional<TcpSocket> peer = listener.accept())
+                {
+                    std::byte byte{1};
+                    peer->send(&byte, 1);
+                    ++accepted;
+                }
+            }
+            Clock::time_point stopped = Clock::now();
+
+            Samples connects;
+            for(size_t i = 0; i < clients; ++i)
+            {
+                workers[i]->join();
+                connects.merge(latencies[i]);
+            }
+
+            double elapsed = seconds(stopped - start);
+            Record record("tcp_accept");
+            record.field("clients", uint64_t(clients))
+                  .field("accepts", accepted)
+                  .field("seconds", elapsed)
+                  .field("accepts_per_s", static_cast<double>(accepted) / elapsed);
+            connects.report(record, "connect_");
+            record.emit();
+        }
+    }
+
+    void tcpFanIn(Options const & options)
+    {
+        // Each connection costs a descriptor on both ends.
+        size_t limit = raiseFileLimit();
+
+        for(size_t connections : {size_t(16), size_t(256), size_t(1024)})
+        {
+            if(connections * 2 + 64 > limit)
+            {
+                Record("tcp_fanin")
+                    .field("connections", uint64_t(connections))
+                    .field("skipped", std::string_view("descriptor limit"))
+                    .emit();
+                continue;
+            }
+
+            TcpServer::Config config;
+            config.workers = 1;
+            TcpServer server(config, serveEcho);
+            server.start();
+
+            Clock::time_point connecting = Clock::now();
+            std::vector<TcpSocket> sockets;
+            sockets.reserve(connections);
+            for(size_t i = 0; i < connections; ++i) sockets.push_back(connectLoopback(server.port()));
+            double connectSeconds = seconds(Clock::now() - connecting);
+
+            // Every client thread writes one message to each of its connections, then
+            // collects the echoes, so the server always has many sockets ready at once.
+            constexpr size_t MessageSize = 64;
+            size_t clients = std::min<size_t>(4, connections);
+            std::vector<uint64_t> messages(clients, 0);
+            std::vector<std::unique_ptr<Worker>> workers;
+
+            Clock::time_point start = Clock::now();
+            Clock::time_point end = start + options.duration;
+            for(size_t i = 0; i < clients; ++i)
+            {
+                workers.push_back(std::make_unique<Worker>([&, i]
+                {
+                    std::byte message[MessageSize];
+                    std::fill(std::begin(message), std::end(message), std::byte{0x5A});
+
+                    while(Clock::now() < end)
+                    {
+                        for(size_t c = i; c < connections; c += clients)
+                        {
+                            if(!sendAll(sockets[c], message, MessageSize)) throw std::runtime_error("fan-in server went away");
+                        }
+                        for(size_t c = i; c < connections; c += clients)
+                        {
+                            if(!recvAll(sockets[c], message, MessageSize)) throw std::runtime_error("fan-in server went away");
+                            ++messages[i];
+                        }
+                    }
+                }));
+            }
+            for(std::unique_ptr<Worker>& worker : workers) worker->join();
+            double elapsed = seconds(Clock::now() - start);
+
+            sockets.clear();
+            server.stop();
+
+            uint64_t total = 0;
+            for(uint64_t count : messages) total += count;
+
+            Record("tcp_fanin")
+                .field("connections", uint64_t(connections))
+                .field("clients", uint64_t(clients))
+                .field("message", uint64_t(MessageSize))
+                .field("connect_seconds", connectSeconds)
+                .field("messages", total)
+                .field("seconds", elapsed)
+                .field("messages_per_s", static_cast<double>(total) / elapsed)
+                .emit();
+        }
+    }
+}
\ No newline at end of file
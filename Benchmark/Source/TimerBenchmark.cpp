@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+
+#include <random>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // Runs op in rounds of 1024 until the duration is spent; returns ns per call.
+        template<typename Op>
+        double measure(Options const & options, Op&& op, uint64_t& calls)
+        {
+            calls = 0;
+            Clock::time_point start = Clock::now();
+            Clock::time_point end = start + options.duration;
+            Clock::time_point now = start;
+            while(now < end)
+            {
+                for(size_t i = 0; i < 1024; ++i) op(calls++);
+                now = Clock::now();
+            }
+            return seconds(now - start) * 1e9 / static_cast<double>(calls);
+        }
+    }
+
+    // Per-connection deadlines: many live timers that are pushed back on every read
+    // (rearm), or replaced wholesale (cancel + runAfter), plus the cost of a loop pass
+    // that has to find the next expiry among them.
+    void eventTimers(Options const & options)
+    {
+        for(size_t live : {size_t(1024), size_t(65536)})
+        {
+            EventLoop loop(EventLoop::Backend::Poll);
+            std::mt19937_64 random(live);
+            std::uniform_int_distribution<int> delay(1000, 60000);
+
+            std::vector<EventLoop::TimerId> timers(live);
+            for(EventLoop::TimerId& id : timers) id = loop.runAfter(std::chrono::milliseconds(delay(random)), [] {});
+
+            uint64_t rearms;
+            double rearmNs = measure(options, [&](uint64_t i)
+            {
+                loop.rearmTimer(timers[i % live], std::chrono::milliseconds(delay(random)));
+            }, rearms);
+
+            uint64_t replaces;
+            double replaceNs = measure(options, [&](uint64_t i)
+            {
+                EventLoop::TimerId& id = timers[i % live];
+                loop.cancelTimer(id);
+                id = loop.runAfter(std::chrono::milliseconds(delay(random)), [] {});
+            }, replaces);
+
+            uint64_t passes;
+            double passNs = measure(options, [&](uint64_t)
+            {
+                loop.runOnce(0);
+            }, passes);
+
+            Record("event_timers")
+                .field("timers", uint64_t(live))
+                .field("rearms", rearms)
+                .field("rearm_ns", rearmNs)
+                .field("replaces", replaces)
+                .field("replace_ns", replaceNs)
+                .field("passes", passes)
+                .field("pass_ns", passNs)
+                .emit();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "Benchmark.hpp"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+namespace Benchmark
+{
+    namespace
+    {
+        constexpr size_t BatchSize = 64;
+
+        enum class Mode
+        {
+            Single,     // sendTo/recvFrom
+            Batch,      // sendBatch/recvBatch
+            Offload     // sendSegments/recvSegments with UDP_SEGMENT/UDP_GRO
+        };
+
+        std::string_view name(Mode mode) noexcept
+        {
+            switch(mode)
+            {
+            case Mode::Single: return "single";
+            case Mode::Batch: return "batch";
+            default: return "offload";
+            }
+        }
+
+        uint16_t boundPort(UdpSocket& socket)
+        {
+            sockaddr_in addr{};
+            socklen_t length = sizeof(addr);
+            if(::getsockname(socket.native(), reinterpret_cast<sockaddr*>(&addr), &length) < 0) throw std::runtime_error("getsockname failed");
+            return ntohs(addr.sin_port);
+        }
+
+        uint64_t blast(UdpSocket& socket, Endpoint const & peer, size_t size, Mode mode, Clock::time_point end)
+        {
+            std::vector<std::byte> payload(size * BatchSize, std::byte{0x5A});
+            uint64_t sent = 0;
+
+            if(mode == Mode::Offload)
+            {
+                size_t offset = 0;
+                while(Clock::now() < end)
+                {
+                    Result res = socket.sendSegments(peer, payload.data() + offset, payload.size() - offset, size);
+                    if(res.type == ResultType::WouldBlock)
+                    {
+                        socket.waitWrite(-1);
+                        continue;
+                    }
+                    if(res.type != ResultType::Data) throw std::runtime_error("sendSegments failed");
+
+                    sent += (res.bytes + size - 1) / size;
+                    offset = (offset + res.bytes) % payload.size();
+                }
+                return sent;
+            }
+
+            if(mode == Mode::Single)
+            {
+                while(Clock::now() < end)
+                {
+                    Result res = socket.sendTo(peer, payload.data(), size);
+                    if(res.type == ResultType::WouldBlock) socket.waitWrite(-1);
+                    else if(res.type == ResultType::Data) ++sent;
+                    else throw std::runtime_error("sendTo failed");
+                }
+                return sent;
+            }
+
+            UdpBatch batch(BatchSize);
+            for(size_t i = 0; i < BatchSize; ++i) batch.push(peer, payload.data(), size);
+
+            size_t first = 0;
+            while(Clock::now() < end)
+            {
+                Result res = socket.sendBatch(batch, first);
+                if(res.type == ResultType::WouldBlock)
+                {
+                    socket.waitWrite(-1);
+                    continue;
+                }
+                if(res.type != ResultType::Data) throw std::runtime_error("sendBatch failed");
+
+                sent += res.bytes;
+                first = (first + res.bytes) % BatchSize;
+            }
+            return sent;
+        }
+    }
+
+    void udpPackets(Options const & options)
+    {
+        for(Mode mode : {Mode::Single, Mode::Batch, Mode::Offload})
+        {
+            for(size_t size : {size_t(64), size_t(512), size_t(1400)})
+            {
+                UdpSocket receiver;
+                receiver.bind(0);
+                if(mode == Mode::Offload && !receiver.setReceiveOffload(true)) throw std::runtime_error("UDP_GRO failed");
+                Endpoint peer = loopback(boundPort(receiver));
+
+                std::atomic<bool> sending{true};
+                uint64_t sent = 0;
+
+                Clock::time_point start = Clock::now();
+                Clock::time_point end = start + options.duration;
+
+                Worker sender([&]
+                {
+                    UdpSocket socket;
+                    sent = blast(socket, peer, size, mode, end);
+                    sending = false;
+                });
+
+                // Datagrams the receiver can't keep up with are dropped by the kernel and
+                // show up as loss rather than as back-pressure on the sender.
+                std::vector<std::byte> storage(BatchSize * 2048);
+                UdpBatch batch(BatchSize);
+                for(size_t i = 0; i < BatchSize; ++i) batch.setBuffer(i, storage.data() + i * 2048, 2048);
+
+                uint64_t received = 0;
+                Clock::time_point last = start;
+                while(true)
+                {
+                    Result res;
+                    if(mode == Mode::Batch)
+                    {
+                        res = receiver.recvBatch(batch);
+                    }
+                    else if(mode == Mode::Offload)
+                    {
+                        Endpoint from;
+                        size_t segment = 0;
+                        res = receiver.recvSegments(from, storage.data(), storage.size(), segment);
+                        if(res.type == ResultType::Data) res.bytes = segment == 0 ? 1 : (res.bytes + segment - 1) / segment;
+                    }
+                    else
+                    {
+                        Endpoint from;
+                        res = receiver.recvFrom(from, storage.data(), storage.size());
+                        if(res.type == ResultType::Data) res.bytes = 1;
+                    }
+
+                    if(res.type == ResultType::Data)
+                    {
+                        received += res.bytes;
+                        last = Clock::now();
+                    }
+                    else if(res.type == ResultType::WouldBlock)
+                    {
+                        if(!receiver.waitRead(sending ? 100 : 20) && !sending) break;
+                    }
+                    else
+                    {
+                        throw std::runtime_error("receive failed");
+                    }
+                }
+                sender.join();
+
+                double elapsed = seconds(last - start);
+                Record("udp_pps")
+                    .field("mode", name(mode))
+                    .field("size", uint64_t(size))
+                    .field("sent", sent)
+                    .field("received", received)
+                    .field("loss", sent == 0 ? 0.0 : 1.0 - static_cast<double>(received) / static_cast<double>(sent))
+                    .field("seconds", elapsed)
+                    .field("sent_per_s", static_cast<double>(sent) / seconds(options.duration))
+                    .field("received_per_s", static_cast<double>(received) / elapsed)
+                    .field("mib_per_s", static_cast<double>(received * size) / elapsed / (1024.0 * 1024.0))
+                    .emit();
+            }
+        }
+    }
+
+    void udpReliable(Options const & options)
+    {
+        // A message every 50 us on one reliable ordered channel, one thread driving both
+        // ends, so latency is delivery delay (recovery included) rather than queueing.
+        constexpr auto Interval = std::chrono::microseconds(50);
+
+        for(double loss : {0.0, 0.01, 0.05})
+        {
+            for(size_t size : {size_t(64), size_t(4096)})
+            {
+                UdpSocket a;
+                UdpSocket b;
+                a.bind(loopback(0));
+                b.bind(loopback(0));
+
+                ReliableUdpSession::Config config;
+                config.simulatedLoss = loss;
+                ReliableUdpSession sender(a, loopback(boundPort(b)), config);
+                config.seed = 2;
+                ReliableUdpSession receiver(b, loopback(boundPort(a)), config);
+
+                std::vector<std::byte> payload(size, std::byte{0x5A});
+                Samples latency;
+                latency.reserve(static_cast<size_t>(options.duration / Interval) + 1);
+                uint64_t sent = 0;
+                uint64_t delivered = 0;
+
+                Clock::time_point start = Clock::now();
+                Clock::time_point end = start + options.duration;
+                Clock::time_point next = start;
+                Clock::time_point now = start;
+                while(now < end || delivered < sent)
+                {
+                    if(now > end + std::chrono::seconds(10)) throw std::runtime_error("reliable session stalled");
+
+                    if(now < end && now >= next)
+                    {
+                        int64_t stamp = now.time_since_epoch().count();
+                        std::memcpy(payload.data(), &stamp, sizeof(stamp));
+                        std::memcpy(payload.data() + sizeof(stamp), &sent, sizeof(sent));
+                        if(sender.send(0, payload.data(), size).type == ResultType::Data)
+                        {
+                            ++sent;
+                            next += Interval;
+                        }
+                    }
+
+                    sender.pump(now);
+                    receiver.pump(now);
+
+                    ReliableUdpSession::Message message;
+                    while(receiver.receive(message))
+                    {
+                        int64_t stamp;
+                        uint64_t sequence;
+                        std::memcpy(&stamp, message.data.data(), sizeof(stamp));
+                        std::memcpy(&sequence, message.data.data() + sizeof(stamp), sizeof(sequence));
+                        if(message.data.size() != size || sequence != delivered) throw std::runtime_error("reliable session misordered");
+
+                        latency.add(Clock::now() - Clock::time_point(Clock::duration(stamp)));
+                        ++delivered;
+                    }
+                    now = Clock::now();
+                }
+
+                ReliableUdpSession::Stats stats = sender.stats();
+                Record record("udp_reliable");
+                record.field("loss", loss)
+                      .field("size", uint64_t(size))
+                      .field("messages", delivered)
+                      .field("packets", stats.packetsSent)
+                      .field("retransmits", stats.retransmits)
+                      .field("probes", stats.probes);
+                latency.report(record, "latency_");
+                record.emit();
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "Test.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        // A connected loopback pair, both ends non-blocking.
+        std::pair<TcpSocket, TcpSocket> connectedPair()
+        {
+            TcpSocket listener(AddressFamily::IPv4);
+            CHECK(listener.listen(Endpoint::parse("127.0.0.1", 0).value()));
+
+            TcpSocket client(AddressFamily::IPv4);
+            CHECK(client.connect(Endpoint::parse("127.0.0.1", listener.localPort()).value(), 1000));
+            std::optional<TcpSocket> server = listener.accept();
+            CHECK(server.has_value());
+
+            CHECK(client.setNonBlocking(true));
+            CHECK(server->setNonBlocking(true));
+            return {std::move(client), std::move(*server)};
+        }
+
+        // Reads from peer until size bytes arrived, running loop (when given) in between.
+        std::string receive(TcpSocket& peer, size_t size, EventLoop* loop = nullptr)
+        {
+            std::string received;
+            std::vector<char> buffer(64 * 1024);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while(received.size() < size && std::chrono::steady_clock::now() < deadline)
+            {
+                Result res = peer.recv(buffer.data(), buffer.size());
+                if(res.type == ResultType::Data) received.append(buffer.data(), res.bytes);
+                if(loop != nullptr) loop->runOnce(res.type == ResultType::Data ? 0 : 1);
+                else if(res.type == ResultType::WouldBlock) peer.waitRead(10);
+            }
+            return received;
+        }
+    }
+
+    void bufferedTcpStream()
+    {
+        // Small writes are coalesced until flush() and arrive in order.
+        {
+            auto [client, server] = connectedPair();
+            BufferedTcpStream stream(std::move(client));
+
+            CHECK(stream.write("abc", 3).type == ResultType::Data);
+            CHECK(stream.write("def", 3).type == ResultType::Data);
+            CHECK(stream.pending() == 6);
+
+            Result res = stream.flush();
+            CHECK(res.type == ResultType::Data && res.bytes == 6);
+            CHECK(stream.pending() == 0);
+            CHECK(receive(server, 6) == "abcdef");
+        }
+
+        // Lines split across segments, with either terminator, and exact reads.
+        {
+            auto [client, server] = connectedPair();
+            BufferedTcpStream stream(std::move(server));
+            std::string_view line;
+
+            CHECK(client.send("hello\r\nwor", 10).type == ResultType::Data);
+            CHECK(stream.socket().waitRead(1000));
+            CHECK(stream.readLine(line).type == ResultType::Data);
+            CHECK(line == "hello");
+            CHECK(stream.readLine(line).type == ResultType::WouldBlock);
+
+            CHECK(client.send("ld\n1234", 7).type == ResultType::Data);
+            CHECK(stream.socket().waitRead(1000));
+            CHECK(stream.readLine(line).type == ResultType::Data);
+            CHECK(line == "world");
+
+            char exact[6];
+            CHECK(stream.readExact(exact, sizeof(exact)).type == ResultType::WouldBlock);
+            CHECK(stream.buffered() == 4);
+            CHECK(client.send("56", 2).type == ResultType::Data);
+            CHECK(stream.socket().waitRead(1000));
+            CHECK(stream.readExact(exact, sizeof(exact)).type == ResultType::Data);
+            CHECK(std::string_view(exact, sizeof(exact)) == "123456");
+        }
+
+        // With a loop, queued bytes go out at the end of the iteration.
+        {
+            auto [client, server] = connectedPair();
+            EventLoop loop;
+            BufferedTcpStream::Config config;
+            config.loop = &loop;
+            BufferedTcpStream stream(std::move(client), config);
+
+            CHECK(stream.write("ping", 4).type == ResultType::Data);
+            CHECK(stream.pending() == 4);
+            loop.runOnce(1000);
+            CHECK(stream.pending() == 0);
+            CHECK(receive(server, 4) == "ping");
+        }
+
+        // A flush that would block resumes on writability, through the stream's own
+        // registration or through Write added to the owner's, which is then restored.
+        for(bool shared : {false, true})
+        {
+            auto [client, server] = connectedPair();
+            EventLoop loop;
+            BufferedTcpStream::Config config;
+            config.loop = &loop;
+            config.flushThreshold = size_t(1) << 30;
+            config.maxQueued = size_t(64) << 20;
+            BufferedTcpStream stream(std::move(client), config);
+
+            if(shared)
+            {
+                CHECK(loop.add(stream.socket().native(), Event::Read, [&](Event events)
+                {
+                    if(has(events, Event::Write)) stream.flush();
+                }));
+            }
+
+            std::string chunk(100, 'x');
+            constexpr size_t Writes = 100000;
+            for(size_t i = 0; i < Writes; ++i) CHECK(stream.write(chunk.data(), chunk.size()).type == ResultType::Data);
+
+            loop.runOnce(0);
+            CHECK(stream.pending() > 0);
+            CHECK(has(loop.interest(stream.socket().native()), Event::Write));
+
+            CHECK(receive(server, Writes * chunk.size(), &loop).size() == Writes * chunk.size());
+            loop.runOnce(0);
+            CHECK(stream.pending() == 0);
+            CHECK(loop.interest(stream.socket().native()) == (shared ? Event::Read : Event::None));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "Test.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <string_view>
+#include <sys/socket.h>
+#include <utility>
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        // A connected loopback pair; both ends stay blocking, as the engine expects.
+        std::pair<TcpSocket, TcpSocket> connectedPair()
+        {
+            TcpSocket listener(AddressFamily::IPv4);
+            CHECK(listener.listen(Endpoint::parse("127.0.0.1", 0).value()));
+
+            TcpSocket client(AddressFamily::IPv4);
+            CHECK(client.connect(Endpoint::parse("127.0.0.1", listener.localPort()).value(), 1000));
+            std::optional<TcpSocket> server = listener.accept();
+            CHECK(server.has_value());
+            return {std::move(client), std::move(*server)};
+        }
+
+        // Runs the engine until count completions arrived or a few seconds passed.
+        std::vector<CompletionEngine::Completion> collect(CompletionEngine& engine, size_t count)
+        {
+            std::vector<CompletionEngine::Completion> completions;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while(completions.size() < count && std::chrono::steady_clock::now() < deadline)
+            {
+                engine.run(100, [&](CompletionEngine::Completion const & completion)
+                {
+                    completions.push_back(completion);
+                });
+            }
+            return completions;
+        }
+
+        CompletionEngine::Completion const * find(std::vector<CompletionEngine::Completion> const & completions, uint64_t userData)
+        {
+            for(CompletionEngine::Completion const & completion : completions)
+            {
+                if(completion.userData == userData) return &completion;
+            }
+            return nullptr;
+        }
+    }
+
+    void completionEngine()
+    {
+        if(!CompletionEngine::supported()) return;
+
+        // A send and the matching receive complete under their own userData.
+        {
+            auto [client, server] = connectedPair();
+            CompletionEngine engine;
+
+            char received[16] = {};
+            CHECK(engine.recv(server.native(), received, sizeof(received), 2));
+            CHECK(engine.send(client.native(), "hello", 5, 1));
+
+            std::vector<CompletionEngine::Completion> completions = collect(engine, 2);
+            CHECK(completions.size() == 2);
+            CompletionEngine::Completion const * sent = find(completions, 1);
+            CompletionEngine::Completion const * recv = find(completions, 2);
+            CHECK(sent != nullptr && sent->operation == CompletionEngine::Operation::Send);
+            CHECK(sent->result.type == ResultType::Data && sent->result.bytes == 5);
+            CHECK(recv != nullptr && recv->operation == CompletionEngine::Operation::Recv);
+            CHECK(recv->result.type == ResultType::Data);
+            CHECK(std::string_view(received, recv->result.bytes) == "hello");
+            CHECK(engine.inFlight() == 0);
+        }
+
+        // With nothing ready run() returns after its timeout, and a pending receive can
+        // be cancelled: both it and the cancel complete and free their slots.
+        {
+            auto [client, server] = connectedPair();
+            CompletionEngine engine;
+
+            char received[16];
+            CHECK(engine.recv(server.native(), received, sizeof(received), 7));
+            auto start = std::chrono::steady_clock::now();
+            CHECK(engine.run(50, [](CompletionEngine::Completion const &) {}) == 0);
+            CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+            CHECK(engine.inFlight() == 1);
+
+            CHECK(engine.cancel(7));
+            std::vector<CompletionEngine::Completion> completions = collect(engine, 2);
+            CHECK(completions.size() == 2);
+            bool cancelled = false;
+            bool aborted = false;
+            for(CompletionEngine::Completion const & completion : completions)
+            {
+                CHECK(completion.userData == 7);
+                if(completion.operation == CompletionEngine::Operation::Cancel) cancelled = true;
+                if(completion.operation == CompletionEngine::Operation::Recv) aborted = completion.result.type == ResultType::Error;
+            }
+            CHECK(cancelled && aborted);
+            CHECK(engine.inFlight() == 0);
+        }
+
+        // Registered buffers round-trip through sendFixed and recvFixed.
+        {
+            auto [client, server] = connectedPair();
+            CompletionEngine engine;
+
+            std::vector<char> out(32 * 1024);
+            std::vector<char> in(out.size());
+            for(size_t i = 0; i < out.size(); ++i) out[i] = static_cast<char>(i * 7);
+            MutableBufferView buffers[] = {{out.data(), out.size()}, {in.data(), in.size()}};
+            CHECK(engine.registerBuffers(buffers));
+
+            CHECK(engine.sendFixed(client.native(), 0, 0, out.size(), 1));
+            size_t received = 0;
+            bool sent = false;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            CHECK(engine.recvFixed(server.native(), 1, 0, in.size(), 2));
+            while((!sent || received < in.size()) && std::chrono::steady_clock::now() < deadline)
+            {
+                engine.run(100, [&](CompletionEngine::Completion const & completion)
+                {
+                    CHECK(completion.result.type == ResultType::Data);
+                    if(completion.userData == 1)
+                    {
+                        CHECK(completion.result.bytes == out.size());
+                        sent = true;
+                        return;
+                    }
+                    received += completion.result.bytes;
+                    if(received < in.size()) CHECK(engine.recvFixed(server.native(), 1, received, in.size() - received, 2));
+                });
+            }
+            CHECK(sent && received == in.size());
+            CHECK(std::memcmp(out.data(), in.data(), in.size()) == 0);
+            CHECK(engine.inFlight() == 0);
+        }
+
+        // sendFixed to a peer that reset the connection reports Disconnected instead
+        // of raising SIGPIPE, which is back to its default action here.
+        {
+            auto [client, server] = connectedPair();
+            CompletionEngine engine;
+
+            std::vector<char> out(4096, 'x');
+            MutableBufferView buffers[] = {{out.data(), out.size()}};
+            CHECK(engine.registerBuffers(buffers));
+
+            linger reset{1, 0};
+            CHECK(::setsockopt(server.native(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset)) == 0);
+            {
+                TcpSocket closing(std::move(server));
+            }
+
+            auto previous = std::signal(SIGPIPE, SIG_DFL);
+            bool disconnected = false;
+            for(uint64_t attempt = 0; attempt < 3; ++attempt)
+            {
+                CHECK(engine.sendFixed(client.native(), 0, 0, out.size(), attempt));
+                std::vector<CompletionEngine::Completion> completions = collect(engine, 1);
+                if(completions.size() == 1 && completions[0].result.type == ResultType::Disconnected) disconnected = true;
+            }
+            std::signal(SIGPIPE, previous);
+            CHECK(disconnected);
+        }
+
+        // An accept completes with a blocking socket for the new connection.
+        {
+            TcpSocket listener(AddressFamily::IPv4);
+            CHECK(listener.listen(Endpoint::parse("127.0.0.1", 0).value()));
+            CompletionEngine engine;
+
+            CHECK(engine.accept(listener.native(), 3));
+            CHECK(engine.submit() == 1);
+            TcpSocket client(AddressFamily::IPv4);
+            CHECK(client.connect(Endpoint::parse("127.0.0.1", listener.localPort()).value(), 1000));
+
+            std::vector<CompletionEngine::Completion> completions = collect(engine, 1);
+            CHECK(completions.size() == 1);
+            CHECK(completions[0].operation == CompletionEngine::Operation::Accept);
+            CHECK(completions[0].result.type == ResultType::Data && completions[0].accepted >= 0);
+
+            TcpSocket accepted = TcpSocket::adopt(completions[0].accepted);
+            CHECK(client.send("ok", 2).type == ResultType::Data);
+            char received[2];
+            CHECK(accepted.recv(received, sizeof(received)).type == ResultType::Data);
+            CHECK(std::string_view(received, 2) == "ok");
+        }
+    }
+}
\ No newline at end of file
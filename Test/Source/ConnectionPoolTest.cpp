@@ -0,0 +1,161 @@
+#include "Test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        // A loopback listener whose accepted sockets are kept, so the test can close
+        // the server side of a pooled connection.
+        class Backend
+        {
+        public:
+            Backend() : listener(AddressFamily::IPv4)
+            {
+                CHECK(listener.listen(Endpoint::parse("127.0.0.1", 0).value()));
+                endpoint = Endpoint::parse("127.0.0.1", listener.localPort()).value();
+            }
+
+            TcpSocket& acceptOne()
+            {
+                std::optional<TcpSocket> accepted = listener.accept();
+                CHECK(accepted.has_value());
+                return connections.emplace_back(std::move(*accepted));
+            }
+
+            // Keeps the accept queue from filling up when the pool connects a lot.
+            void acceptPending()
+            {
+                CHECK(listener.setNonBlocking(true));
+                while(std::optional<TcpSocket> accepted = listener.accept()) connections.push_back(std::move(*accepted));
+            }
+
+            Endpoint endpoint;
+            std::vector<TcpSocket> connections;
+
+        private:
+            TcpSocket listener;
+        };
+    }
+
+    void connectionPool()
+    {
+        // Leases come back to the idle list and are reused; discarded ones are not.
+        {
+            Backend backend;
+            ConnectionPool pool;
+
+            Lease first = pool.acquire(backend.endpoint);
+            CHECK(first && !first.reused());
+            CHECK(pool.leased(backend.endpoint) == 1);
+            backend.acceptOne();
+
+            first.release();
+            CHECK(!first);
+            CHECK(pool.leased(backend.endpoint) == 0);
+            CHECK(pool.idle(backend.endpoint) == 1);
+
+            Lease second = pool.tryAcquire(backend.endpoint);
+            CHECK(second && second.reused());
+            CHECK(pool.idle(backend.endpoint) == 0);
+
+            second.discard();
+            CHECK(pool.leased(backend.endpoint) == 0);
+            CHECK(pool.idle(backend.endpoint) == 0);
+            CHECK(!pool.tryAcquire(backend.endpoint));
+        }
+
+        // An idle connection the backend closed is dropped instead of handed out.
+        {
+            Backend backend;
+            ConnectionPool pool;
+
+            pool.acquire(backend.endpoint).release();
+            backend.acceptOne();
+            CHECK(pool.idle(backend.endpoint) == 1);
+
+            backend.connections.clear();
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while(pool.prune() == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            CHECK(pool.idle(backend.endpoint) == 0);
+
+            Lease fresh = pool.acquire(backend.endpoint);
+            CHECK(fresh && !fresh.reused());
+        }
+
+        // At the per-host limit acquire waits for a lease to come back, or times out.
+        {
+            Backend backend;
+            ConnectionPool::Config config;
+            config.maxPerHost = 1;
+            ConnectionPool pool(config);
+
+            Lease held = pool.acquire(backend.endpoint);
+            CHECK(held);
+            CHECK(!pool.acquire(backend.endpoint, 20));
+
+            // prune() and clear() keep running while leases come back and waiters wake:
+            // a host must outlive every acquire() waiting on it.
+            std::atomic<bool> stop{false};
+            std::thread cleaner([&]
+            {
+                for(size_t i = 0; !stop; ++i)
+                {
+                    if(i % 64 == 0) pool.prune();
+                    pool.clear();
+                }
+            });
+
+            size_t served = 0;
+            for(int round = 0; round < 500; ++round)
+            {
+                std::atomic<bool> waiting{false};
+                std::atomic<bool> got{false};
+                std::thread waiter([&]
+                {
+                    waiting = true;
+                    got = static_cast<bool>(pool.acquire(backend.endpoint, 5000));
+                });
+
+                while(!waiting) std::this_thread::yield();
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                held.release();
+                waiter.join();
+                if(got) ++served;
+
+                held = pool.acquire(backend.endpoint, 5000);
+                backend.acceptPending();
+                if(!held) break;
+            }
+
+            stop = true;
+            cleaner.join();
+            CHECK(served == 500);
+            CHECK(held);
+            held.release();
+            CHECK(pool.leased(backend.endpoint) == 0);
+        }
+
+        // A failed connect gives its reserved slot back.
+        {
+            std::optional<Endpoint> closed;
+            {
+                Backend gone;
+                closed = gone.endpoint;
+            }
+
+            ConnectionPool::Config config;
+            config.maxPerHost = 1;
+            config.connectTimeoutMs = 1000;
+            ConnectionPool pool(config);
+            CHECK(!pool.acquire(*closed));
+            CHECK(pool.leased(*closed) == 0);
+            CHECK(!pool.acquire(*closed));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "Test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Test
+{
+    void eventLoop()
+    {
+        // Readiness: a datagram makes the receiver readable until it is read.
+        {
+            EventLoop loop;
+            UdpSocket receiver(AddressFamily::IPv4);
+            CHECK(receiver.bind(Endpoint::parse("127.0.0.1", 0).value()));
+            UdpSocket sender(AddressFamily::IPv4);
+
+            size_t reads = 0;
+            CHECK(loop.add(receiver.native(), Event::Read, [&](Event events)
+            {
+                CHECK(has(events, Event::Read));
+                char byte;
+                Endpoint from;
+                if(receiver.recvFrom(from, &byte, 1).type == ResultType::Data) ++reads;
+            }));
+            CHECK(loop.interest(receiver.native()) == Event::Read);
+
+            CHECK(loop.runOnce(0) == 0);
+            CHECK(sender.sendTo(receiver.localEndpoint(), "x", 1).type == ResultType::Data);
+            CHECK(loop.runOnce(1000) == 1);
+            CHECK(reads == 1);
+
+            CHECK(loop.modify(receiver.native(), Event::None));
+            CHECK(sender.sendTo(receiver.localEndpoint(), "y", 1).type == ResultType::Data);
+            CHECK(loop.runOnce(20) == 0);
+            CHECK(loop.remove(receiver.native()));
+            CHECK(loop.interest(receiver.native()) == Event::None);
+        }
+
+        // Deferred jobs run at the end of the iteration without blocking in between,
+        // and jobs they defer wait for the next one.
+        {
+            EventLoop loop;
+            std::vector<int> order;
+            loop.runAfter(std::chrono::milliseconds(0), [&]{ order.push_back(1); });
+            loop.defer([&]
+            {
+                order.push_back(2);
+                loop.defer([&]{ order.push_back(3); });
+            });
+
+            auto start = std::chrono::steady_clock::now();
+            loop.runOnce(5000);
+            CHECK(order == std::vector<int>({1, 2}));
+            loop.runOnce(5000);
+            CHECK(order == std::vector<int>({1, 2, 3}));
+            CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+        }
+
+        // Posts from other threads always wake the loop: none may be lost between the
+        // wake descriptor being drained and the pending flag being cleared.
+        {
+            EventLoop loop;
+            constexpr size_t Threads = 4;
+            constexpr size_t Posts = 5000;
+            std::atomic<size_t> done{0};
+
+            std::vector<std::thread> posters;
+            for(size_t t = 0; t < Threads; ++t)
+            {
+                posters.emplace_back([&]
+                {
+                    for(size_t i = 0; i < Posts; ++i) loop.post([&]{ ++done; });
+                });
+            }
+
+            // Blocks forever without a timeout if a wake were swallowed.
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+            while(done < Threads * Posts && std::chrono::steady_clock::now() < deadline) loop.runOnce(-1);
+            for(std::thread& poster : posters) poster.join();
+            CHECK(done == Threads * Posts);
+
+            std::thread stopper([&]{ loop.stop(); });
+            loop.run();
+            stopper.join();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Test.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace Test
+{
+    namespace
+    {
+        // Copies bytes into the codec the way a recv would.
+        void feed(FrameCodec& codec, std::string_view bytes)
+        {
+            MutableBufferView target = codec.writable();
+            CHECK(target.size >= bytes.size());
+            std::memcpy(target.data, bytes.data(), bytes.size());
+            codec.commit(bytes.size());
+        }
+
+        std::string text(ConstBufferView frame)
+        {
+            return std::string(static_cast<char const *>(frame.data), frame.size);
+        }
+    }
+
+    void frameCodec()
+    {
+        // Length prefix: a frame split anywhere, header included, waits for its rest.
+        {
+            FrameCodec codec;
+            std::string wire = std::string("\0\0\0\5hello", 9) + std::string("\0\0\0\3abc", 7);
+
+            ConstBufferView frame;
+            for(size_t i = 0; i < 8; ++i)
+            {
+                feed(codec, wire.substr(i, 1));
+                CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            }
+            feed(codec, wire.substr(8, 1));
+            CHECK(codec.next(frame).type == ResultType::Data);
+            CHECK(text(frame) == "hello");
+
+            feed(codec, wire.substr(9, 5));
+            CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            feed(codec, wire.substr(14));
+            Result res = codec.next(frame);
+            CHECK(res.type == ResultType::Data && res.bytes == 3);
+            CHECK(text(frame) == "abc");
+            CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            CHECK(codec.buffered() == 0);
+        }
+
+        // Little-endian two byte prefix; an empty frame is a frame.
+        {
+            FrameCodec::Config config;
+            config.prefixBytes = 2;
+            config.order = FrameCodec::ByteOrder::Little;
+            FrameCodec codec(config);
+
+            std::byte header[8];
+            CHECK(codec.header(0x102, header) == 2);
+            CHECK(header[0] == std::byte{0x02} && header[1] == std::byte{0x01});
+            CHECK(codec.wireSize(5) == 7);
+
+            feed(codec, std::string_view("\0\0\2\0ok", 6));
+            ConstBufferView frame;
+            CHECK(codec.next(frame).type == ResultType::Data && frame.size == 0);
+            CHECK(codec.next(frame).type == ResultType::Data && text(frame) == "ok");
+        }
+
+        // Oversized frames are an Error as soon as the header is in.
+        {
+            FrameCodec::Config config;
+            config.maxFrame = 16;
+            FrameCodec codec(config);
+
+            feed(codec, std::string_view("\0\0\0\x11", 4));
+            ConstBufferView frame;
+            CHECK(codec.next(frame).type == ResultType::Error);
+        }
+
+        // Delimiter framing: the delimiter may arrive split across reads.
+        {
+            FrameCodec codec(FrameCodec::Config{.framing = FrameCodec::Framing::Delimiter, .delimiter = "\r\n"});
+
+            ConstBufferView frame;
+            feed(codec, "first\r");
+            CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            feed(codec, "\nsecond\r\nthi");
+            CHECK(codec.next(frame).type == ResultType::Data && text(frame) == "first");
+            CHECK(codec.next(frame).type == ResultType::Data && text(frame) == "second");
+            CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            feed(codec, "rd\r\n");
+            CHECK(codec.next(frame).type == ResultType::Data && text(frame) == "third");
+        }
+
+        // A frame larger than the initial buffer grows it instead of stalling.
+        {
+            FrameCodec::Config config;
+            config.bufferSize = 16;
+            FrameCodec codec(config);
+
+            std::string payload(1000, 'x');
+            std::string wire = std::string("\0\0\x03\xE8", 4) + payload;
+            ConstBufferView frame;
+            for(size_t offset = 0; offset < wire.size();)
+            {
+                MutableBufferView target = codec.writable();
+                CHECK(target.size > 0);
+                size_t count = std::min(target.size, wire.size() - offset);
+                std::memcpy(target.data, wire.data() + offset, count);
+                codec.commit(count);
+                offset += count;
+                if(offset < wire.size()) CHECK(codec.next(frame).type == ResultType::WouldBlock);
+            }
+            CHECK(codec.next(frame).type == ResultType::Data && text(frame) == payload);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "Test.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace
+{
+    using namespace Test;
+
+    constexpr Case Cases[] =
+    {
+        {"timer_wheel", timerWheel},
+        {"frame_codec", frameCodec},
+        {"resolver", resolver},
+        {"event_loop", eventLoop},
+        {"reliable_udp", reliableUdp},
+        {"buffered_tcp_stream", bufferedTcpStream},
+        {"connection_pool", connectionPool},
+        {"zero_copy_sender", zeroCopySender},
+        {"completion_engine", completionEngine}
+    };
+
+    void usage(char const * program)
+    {
+        std::fprintf(stderr,
+            "usage: %s [--case NAME] [--list]\n"
+            "Runs the unit tests; the exit status is the number of failed cases.\n", program);
+    }
+}
+
+namespace Test
+{
+    void fail(char const * file, int line, char const * expression)
+    {
+        throw Failure{std::string(file) + ':' + std::to_string(line) + ": CHECK(" + expression + ") failed"};
+    }
+}
+
+int main(int argc, char** argv)
+{
+    char const * only = nullptr;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--case") == 0 && i + 1 < argc)
+        {
+            only = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--list") == 0)
+        {
+            for(Case const & entry : Cases) std::printf("%s\n", entry.name);
+            return 0;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int failed = 0;
+    int ran = 0;
+    for(Case const & entry : Cases)
+    {
+        if(only != nullptr && std::strcmp(entry.name, only) != 0) continue;
+
+        ++ran;
+        try
+        {
+            entry.run();
+            std::printf("ok   %s\n", entry.name);
+        }
+        catch(Failure const & failure)
+        {
+            std::printf("FAIL %s: %s\n", entry.name, failure.message.c_str());
+            ++failed;
+        }
+        catch(std::exception const & e)
+        {
+            std::printf("FAIL %s: exception: %s\n", entry.name, e.what());
+            ++failed;
+        }
+    }
+
+    if(ran == 0)
+    {
+        std::fprintf(stderr, "no case named %s\n", only);
+        return 2;
+    }
+    return failed;
+}
\ No newline at end of file
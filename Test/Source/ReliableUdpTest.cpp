@@ -0,0 +1,98 @@
+#include "Test.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        using Clock = ReliableUdpSession::Clock;
+
+        // Distinct contents per message: index in the first four bytes, then a pattern.
+        std::vector<std::byte> message(uint32_t index, size_t size)
+        {
+            std::vector<std::byte> data(std::max<size_t>(size, sizeof(index)));
+            std::memcpy(data.data(), &index, sizeof(index));
+            for(size_t i = sizeof(index); i < data.size(); ++i) data[i] = static_cast<std::byte>(index * 31 + i);
+            return data;
+        }
+
+        uint32_t indexOf(std::vector<std::byte> const & data)
+        {
+            uint32_t index;
+            std::memcpy(&index, data.data(), sizeof(index));
+            return index;
+        }
+    }
+
+    void reliableUdp()
+    {
+        constexpr uint8_t Ordered = 0;
+        constexpr uint8_t Unordered = 1;
+        constexpr uint32_t Messages = 200;
+
+        UdpSocket a(AddressFamily::IPv4);
+        UdpSocket b(AddressFamily::IPv4);
+        CHECK(a.bind(Endpoint::parse("127.0.0.1", 0).value()));
+        CHECK(b.bind(Endpoint::parse("127.0.0.1", 0).value()));
+
+        // Both directions lose a fifth of their packets, acks included.
+        ReliableUdpSession::Config config;
+        config.channels = {ReliableUdpSession::Delivery::ReliableOrdered, ReliableUdpSession::Delivery::ReliableUnordered};
+        config.simulatedLoss = 0.2;
+        config.seed = 7;
+        ReliableUdpSession sender(a, b.localEndpoint(), config);
+        config.seed = 11;
+        ReliableUdpSession receiver(b, a.localEndpoint(), config);
+
+        // Sizes from one byte to several fragments.
+        for(uint32_t i = 0; i < Messages; ++i)
+        {
+            size_t size = (i * 397) % 5000 + 1;
+            std::vector<std::byte> data = message(i, size);
+            CHECK(sender.send(Ordered, data.data(), data.size()).type == ResultType::Data);
+            data = message(Messages + i, size);
+            CHECK(sender.send(Unordered, data.data(), data.size()).type == ResultType::Data);
+        }
+
+        std::vector<uint32_t> ordered;
+        std::set<uint32_t> unordered;
+        Clock::time_point deadline = Clock::now() + std::chrono::seconds(30);
+        while(ordered.size() + unordered.size() < 2 * Messages || sender.pending() > 0)
+        {
+            CHECK(Clock::now() < deadline);
+
+            Clock::time_point now = Clock::now();
+            sender.pump(now);
+            receiver.pump(now);
+
+            ReliableUdpSession::Message received;
+            while(receiver.receive(received))
+            {
+                uint32_t index = indexOf(received.data);
+                size_t size = ((index % Messages) * 397) % 5000 + 1;
+                CHECK(received.data == message(index, size));
+
+                if(received.channel == Ordered) ordered.push_back(index);
+                else CHECK(unordered.insert(index).second);
+            }
+
+            int wait = std::min(sender.timeout(now), receiver.timeout(now));
+            if(wait < 0) wait = std::max(sender.timeout(now), receiver.timeout(now));
+            a.waitRead(std::clamp(wait, 0, 10));
+        }
+
+        // Ordered delivery is exactly the send order; unordered loses nothing either.
+        CHECK(ordered.size() == Messages);
+        for(uint32_t i = 0; i < Messages; ++i) CHECK(ordered[i] == i);
+        CHECK(unordered.size() == Messages);
+        CHECK(*unordered.begin() == Messages && *unordered.rbegin() == 2 * Messages - 1);
+
+        ReliableUdpSession::Stats stats = sender.stats();
+        CHECK(stats.simulatedDrops > 0);
+        CHECK(stats.retransmits > 0);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "Test.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace Test
+{
+    namespace
+    {
+        // A hosts file in the temp directory, removed again on scope exit.
+        class HostsFile
+        {
+        public:
+            explicit HostsFile(char const * contents)
+            {
+                char name[] = "/tmp/network-hosts-XXXXXX";
+                int fd = ::mkstemp(name);
+                CHECK(fd >= 0);
+                path = name;
+
+                size_t size = std::strlen(contents);
+                CHECK(::write(fd, contents, size) == static_cast<ssize_t>(size));
+                ::close(fd);
+            }
+
+            ~HostsFile()
+            {
+                std::remove(path.c_str());
+            }
+
+            std::string path;
+        };
+
+        // Waits for callbacks run on the resolver's workers.
+        struct Latch
+        {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t count = 0;
+
+            void arrive()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++count;
+                done.notify_all();
+            }
+
+            bool wait(size_t expected)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                return done.wait_for(lock, std::chrono::seconds(5), [&]{ return count >= expected; });
+            }
+        };
+    }
+
+    void resolver()
+    {
+        HostsFile hosts(
+            "# comment line\n"
+            "10.0.0.1   backend backend.local\n"
+            "10.0.0.2   backend   # trailing comment\n"
+            "fd00::5    v6only\n"
+            "not-an-ip  ignored\n");
+
+        std::atomic<size_t> lookups{0};
+        Resolver::Lookup table = Resolver::hostsFileLookup(hosts.path);
+
+        Resolver::Config config;
+        config.ttl = std::chrono::milliseconds(200);
+        config.negativeTtl = std::chrono::milliseconds(200);
+        config.lookup = [&](std::string const & host)
+        {
+            ++lookups;
+            // Slow enough that concurrent requests overlap.
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return table(host);
+        };
+        Resolver resolver(config);
+
+        // Every address of the name, in file order, with the requested port.
+        std::vector<Endpoint> endpoints = resolver.resolveNow("backend", 8080);
+        CHECK(endpoints.size() == 2);
+        CHECK(endpoints[0] == *Endpoint::parse("10.0.0.1", 8080));
+        CHECK(endpoints[1] == *Endpoint::parse("10.0.0.2", 8080));
+        CHECK(lookups == 1);
+
+        CHECK(resolver.resolveNow("backend.local", 1).size() == 1);
+        CHECK(resolver.resolveNow("v6only", 443).front() == *Endpoint::parse("fd00::5", 443));
+        CHECK(resolver.resolveNow("ignored", 1).empty());
+        CHECK(resolver.resolveNow("missing", 1).empty());
+        CHECK(lookups == 5);
+
+        // Cache hits, negative ones included, and numeric addresses skip the lookup.
+        CHECK(resolver.resolveNow("backend", 9).front().port() == 9);
+        CHECK(resolver.resolveNow("missing", 1).empty());
+        CHECK(resolver.resolveNow("192.0.2.7", 1).front() == *Endpoint::parse("192.0.2.7", 1));
+        CHECK(lookups == 5);
+
+        Endpoint endpoint;
+        CHECK(resolver.tryResolve("backend", 7, endpoint) && endpoint == *Endpoint::parse("10.0.0.1", 7));
+        CHECK(!resolver.tryResolve("missing", 7, endpoint));
+        CHECK(!resolver.tryResolve("uncached", 7, endpoint));
+
+        // Concurrent requests for one name share a lookup; callbacks run on a worker.
+        resolver.clear();
+        Latch latch;
+        std::vector<size_t> sizes(4, 0);
+        for(size_t i = 0; i < sizes.size(); ++i)
+        {
+            resolver.resolve("backend", static_cast<uint16_t>(i), [&, i](std::vector<Endpoint> const & result)
+            {
+                sizes[i] = result.size();
+                latch.arrive();
+            });
+        }
+        CHECK(latch.wait(sizes.size()));
+        CHECK(lookups == 6);
+        for(size_t size : sizes) CHECK(size == 2);
+
+        // With a loop the callback is posted, even for a cache hit.
+        EventLoop loop;
+        bool called = false;
+        resolver.resolve("backend", 80, [&](std::vector<Endpoint> const & result)
+        {
+            called = result.size() == 2;
+        }, &loop);
+        CHECK(!called);
+        loop.runOnce(1000);
+        CHECK(called);
+
+        // Entries expire after their TTL.
+        std::this_thread::sleep_for(config.ttl + std::chrono::milliseconds(20));
+        CHECK(!resolver.tryResolve("backend", 1, endpoint));
+        CHECK(resolver.resolveNow("backend", 1).size() == 2);
+        CHECK(lookups == 7);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <Network.hpp>
+
+namespace Test
+{
+    using namespace Library::Network;
+
+    // Thrown by CHECK; the runner reports it and goes on with the next case.
+    struct Failure
+    {
+        std::string message;
+    };
+
+    [[noreturn]] void fail(char const * file, int line, char const * expression);
+
+    struct Case
+    {
+        char const * name;
+        void (*run)();
+    };
+
+    void timerWheel();
+    void frameCodec();
+    void resolver();
+    void eventLoop();
+    void reliableUdp();
+    void bufferedTcpStream();
+    void connectionPool();
+    void zeroCopySender();
+    void completionEngine();
+}
+
+#define CHECK(expression) do { if(!(expression)) ::Test::fail(__FILE__, __LINE__, #expression); } while(false)
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Test.hpp"
+#include "Network/TimerWheel.hpp"
+
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        using Clock = TimerWheel::Clock;
+        using std::chrono::milliseconds;
+
+        // Runs everything due at now; returns how many fired.
+        size_t fire(TimerWheel& wheel, Clock::time_point now)
+        {
+            std::vector<std::function<void()>> jobs;
+            wheel.expire(now, jobs);
+            for(auto& job : jobs) job();
+            return jobs.size();
+        }
+    }
+
+    void timerWheel()
+    {
+        Clock::time_point origin = Clock::now();
+        TimerWheel wheel(origin);
+        std::vector<int> order;
+        auto tag = [&order](int value)
+        {
+            return [&order, value]{ order.push_back(value); };
+        };
+
+        CHECK(wheel.timeout(origin) == -1);
+
+        // Expiry order follows deadlines, whatever the insertion order and level.
+        TimerWheel::TimerId late = wheel.add(origin, milliseconds(70000), tag(4));
+        wheel.add(origin, milliseconds(300), tag(2));
+        wheel.add(origin, milliseconds(5), tag(1));
+        TimerWheel::TimerId cancelled = wheel.add(origin, milliseconds(1000), tag(99));
+        wheel.add(origin, milliseconds(2000), tag(3));
+        CHECK(wheel.size() == 5);
+
+        CHECK(wheel.cancel(cancelled));
+        CHECK(!wheel.cancel(cancelled));
+        CHECK(wheel.size() == 4);
+
+        // Never early: the wait covers the first deadline, and nothing fires before it.
+        CHECK(wheel.timeout(origin) > 0 && wheel.timeout(origin) <= 5);
+        fire(wheel, origin + milliseconds(4));
+        CHECK(order.empty());
+
+        fire(wheel, origin + milliseconds(5));
+        CHECK(order == std::vector<int>({1}));
+
+        fire(wheel, origin + milliseconds(2500));
+        CHECK(order == std::vector<int>({1, 2, 3}));
+
+        // Rearming moves the deadline and keeps the job; a fired timer can't be rearmed.
+        CHECK(wheel.rearm(late, origin + milliseconds(2500), milliseconds(10)));
+        fire(wheel, origin + milliseconds(2509));
+        CHECK(order.size() == 3);
+        fire(wheel, origin + milliseconds(2510));
+        CHECK(order == std::vector<int>({1, 2, 3, 4}));
+        CHECK(!wheel.rearm(late, origin + milliseconds(2510), milliseconds(10)));
+        CHECK(wheel.size() == 0);
+        CHECK(wheel.timeout(origin + milliseconds(2510)) == -1);
+
+        // A timer beyond the top level's range parks and is re-filed; it still fires
+        // exactly at its deadline after a long gap between expire calls.
+        Clock::time_point base = origin + milliseconds(2510);
+        milliseconds far(int64_t(1) << 33);
+        wheel.add(base, far, tag(5));
+        fire(wheel, base + far - milliseconds(1));
+        CHECK(order.size() == 4);
+        fire(wheel, base + far);
+        CHECK(order.back() == 5);
+
+        // Slots are recycled: ids of released timers go stale.
+        std::vector<TimerWheel::TimerId> ids;
+        for(int i = 0; i < 1000; ++i) ids.push_back(wheel.add(base + far, milliseconds(i % 300), []{}));
+        CHECK(wheel.size() == 1000);
+        CHECK(fire(wheel, base + far + milliseconds(300)) == 1000);
+        for(TimerWheel::TimerId id : ids) CHECK(!wheel.cancel(id));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Test.hpp"
+
+#include <chrono>
+#include <string>
+#include <sys/socket.h>
+#include <utility>
+#include <vector>
+
+namespace Test
+{
+    namespace
+    {
+        // A connected loopback pair; the sending end is non-blocking.
+        std::pair<TcpSocket, TcpSocket> connectedPair()
+        {
+            TcpSocket listener(AddressFamily::IPv4);
+            CHECK(listener.listen(Endpoint::parse("127.0.0.1", 0).value()));
+
+            TcpSocket client(AddressFamily::IPv4);
+            CHECK(client.connect(Endpoint::parse("127.0.0.1", listener.localPort()).value(), 1000));
+            std::optional<TcpSocket> server = listener.accept();
+            CHECK(server.has_value());
+
+            CHECK(client.setNonBlocking(true));
+            CHECK(server->setNonBlocking(true));
+            return {std::move(client), std::move(*server)};
+        }
+
+        size_t discard(TcpSocket& peer, size_t size)
+        {
+            size_t received = 0;
+            std::vector<char> buffer(64 * 1024);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while(received < size && std::chrono::steady_clock::now() < deadline)
+            {
+                Result res = peer.recv(buffer.data(), buffer.size());
+                if(res.type == ResultType::Data) received += res.bytes;
+                else peer.waitRead(10);
+            }
+            return received;
+        }
+    }
+
+    void zeroCopySender()
+    {
+        // Releases run in send order: a copied send queued behind a zero-copy one waits
+        // for it, and with nothing pending a copied send releases at once.
+        {
+            auto [client, server] = connectedPair();
+            ZeroCopySender sender(std::move(client));
+            std::string order;
+
+            std::vector<char> large(64 * 1024, 'x');
+            std::vector<char> small(100, 'y');
+            Result res = sender.send(large.data(), large.size(), [&]{ order += 'A'; });
+            CHECK(res.type == ResultType::Data && res.bytes > 0);
+            size_t sent = res.bytes;
+
+            res = sender.send(small.data(), small.size(), [&]{ order += 'B'; });
+            CHECK(res.type == ResultType::Data && res.bytes == small.size());
+            sent += res.bytes;
+            if(sender.enabled())
+            {
+                CHECK(order.empty());
+                CHECK(sender.pending() == 2);
+            }
+
+            CHECK(discard(server, sent) == sent);
+            CHECK(sender.drain(5000));
+            CHECK(order == "AB");
+            CHECK(sender.pending() == 0);
+
+            CHECK(sender.send(small.data(), small.size(), [&]{ order += 'C'; }).type == ResultType::Data);
+            CHECK(order == "ABC");
+        }
+
+        // A Buffer stays referenced until the kernel is done with its bytes.
+        {
+            auto [client, server] = connectedPair();
+            ZeroCopySender sender(std::move(client));
+            BufferPool pool(64 * 1024, 4);
+
+            Buffer buffer = pool.acquire();
+            CHECK(buffer);
+            buffer.resize(buffer.capacity());
+            Result res = sender.send(buffer);
+            CHECK(res.type == ResultType::Data && res.bytes > 0);
+            if(sender.enabled()) CHECK(buffer.useCount() == 2);
+
+            CHECK(discard(server, res.bytes) == res.bytes);
+            CHECK(sender.drain(5000));
+            CHECK(buffer.useCount() == 1);
+        }
+
+        // A reset peer ends drain() instead of leaving it polling a socket error, and
+        // waitCompletions() then takes that error rather than reporting completions.
+        {
+            auto [client, server] = connectedPair();
+            ZeroCopySender sender(std::move(client));
+
+            std::vector<char> large(1 << 20, 'x');
+            while(sender.send(large.data(), large.size(), []{}).type == ResultType::Data)
+            {
+            }
+
+            linger reset{1, 0};
+            CHECK(::setsockopt(server.native(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset)) == 0);
+            {
+                TcpSocket closing(std::move(server));
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            sender.drain(2000);
+            CHECK(!sender.waitCompletions(100));
+            CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1500));
+            CHECK(sender.pending() == 0);
+        }
+    }
+}
\ No newline at end of file
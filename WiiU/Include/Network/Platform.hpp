@@ -0,0 +1,229 @@
+#pragma once
+
+#include "Network/Define.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// The Wii U stack is IPv4 only.
+#if defined(_WIN32) || defined(__linux__)
+#define NETWORK_HAS_IPV6 1
+#endif
+
+namespace Library::Network
+{
+    // Compile-time platform layer. Everything that is spelled differently between
+    // Berkeley sockets (Linux, Wii U) and Winsock goes through here, so TcpSocket,
+    // UdpSocket and EventLoop exist once and each call inlines to the native one.
+    // Features only one platform has (epoll, sendmmsg, sendfile) stay behind #if in
+    // the shared sources, with a portable fallback next to them. The Winsock branch
+    // has not been built with MinGW yet; Windows/ still builds its own sources.
+#if defined(_WIN32)
+    struct Platform
+    {
+        using Handle = SocketFD;
+        using Length = int;
+        using PollDescriptor = WSAPOLLFD;
+
+        static constexpr Handle Invalid = INVALID_SOCKET;
+        static constexpr int ShutdownBoth = SD_BOTH;
+        static constexpr int ReuseAddress = SO_EXCLUSIVEADDRUSE;
+        static constexpr int FamilyUnsupported = WSAEAFNOSUPPORT;
+        static constexpr int OptionUnsupported = WSAENOPROTOOPT;
+        static constexpr bool HasEpoll = false;
+
+        static void startup() noexcept
+        {
+            WSADATA data;
+            ::WSAStartup(MAKEWORD(2, 2), &data);
+        }
+
+        static void cleanup() noexcept
+        {
+            ::WSACleanup();
+        }
+
+        static bool valid(Handle fd) noexcept { return fd != INVALID_SOCKET; }
+        static void close(Handle fd) noexcept { ::closesocket(fd); }
+
+        static int lastError() noexcept { return ::WSAGetLastError(); }
+        static void setLastError(int error) noexcept { ::WSASetLastError(error); }
+
+        static std::system_error failure(char const * call)
+        {
+            return std::system_error(::WSAGetLastError(), std::system_category(), call);
+        }
+
+        static bool wouldBlock(int error) noexcept { return error == WSAEWOULDBLOCK; }
+        static bool connectPending(int error) noexcept { return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS || error == WSAEALREADY; }
+        static bool alreadyConnected(int error) noexcept { return error == WSAEISCONN; }
+        static bool notConnected(int error) noexcept { return error == WSAENOTCONN; }
+        static bool interrupted(int error) noexcept { return error == WSAEINTR; }
+        static bool aborted(int error) noexcept { return error == WSAECONNABORTED; }
+
+        static bool connectionLost(int error) noexcept
+        {
+            return error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAENOTCONN || error == WSAESHUTDOWN;
+        }
+
+        static bool setNonBlocking(Handle fd, bool enable) noexcept
+        {
+            u_long mode = enable ? 1 : 0;
+            return ::ioctlsocket(fd, FIONBIO, &mode) == 0;
+        }
+
+        static int poll(PollDescriptor* fds, size_t count, int timeoutMs) noexcept
+        {
+            return ::WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+        }
+
+        static ptrdiff_t send(Handle fd, void const * data, size_t size, int flags) noexcept
+        {
+            return ::send(fd, static_cast<char const *>(data), clamp(size), flags);
+        }
+
+        static ptrdiff_t recv(Handle fd, void * data, size_t size, int flags) noexcept
+        {
+            return ::recv(fd, static_cast<char*>(data), clamp(size), flags);
+        }
+
+        static ptrdiff_t sendTo(Handle fd, void const * data, size_t size, int flags, sockaddr const * addr, Length length) noexcept
+        {
+            return ::sendto(fd, static_cast<char const *>(data), clamp(size), flags, addr, length);
+        }
+
+        static ptrdiff_t recvFrom(Handle fd, void * data, size_t size, int flags, sockaddr* addr, Length* length) noexcept
+        {
+            return ::recvfrom(fd, static_cast<char*>(data), clamp(size), flags, addr, length);
+        }
+
+        template<typename T>
+        static bool setOption(Handle fd, int level, int name, T const & value) noexcept
+        {
+            return ::setsockopt(fd, level, name, reinterpret_cast<char const *>(&value), sizeof(value)) == 0;
+        }
+
+        template<typename T>
+        static bool getOption(Handle fd, int level, int name, T& value) noexcept
+        {
+            Length size = sizeof(value);
+            return ::getsockopt(fd, level, name, reinterpret_cast<char*>(&value), &size) == 0;
+        }
+
+    private:
+        // Winsock lengths are int; larger requests become short transfers.
+        static int clamp(size_t size) noexcept
+        {
+            return static_cast<int>(std::min<size_t>(size, INT_MAX));
+        }
+    };
+#else
+    struct Platform
+    {
+        using Handle = SocketFD;
+        using Length = socklen_t;
+        using PollDescriptor = pollfd;
+
+        static constexpr Handle Invalid = -1;
+        static constexpr int ShutdownBoth = SHUT_RDWR;
+        static constexpr int ReuseAddress = SO_REUSEADDR;
+        static constexpr int FamilyUnsupported = EAFNOSUPPORT;
+        static constexpr int OptionUnsupported = ENOPROTOOPT;
+#if defined(__linux__)
+        static constexpr bool HasEpoll = true;
+#else
+        static constexpr bool HasEpoll = false;
+#endif
+
+        static void startup() noexcept {}
+        static void cleanup() noexcept {}
+
+        static bool valid(Handle fd) noexcept { return fd >= 0; }
+        static void close(Handle fd) noexcept { ::close(fd); }
+
+        static int lastError() noexcept { return errno; }
+        static void setLastError(int error) noexcept { errno = error; }
+
+        static std::system_error failure(char const * call)
+        {
+            return std::system_error(errno, std::generic_category(), call);
+        }
+
+        static bool wouldBlock(int error) noexcept { return error == EAGAIN || error == EWOULDBLOCK; }
+        static bool connectPending(int error) noexcept { return error == EINPROGRESS || error == EAGAIN || error == EWOULDBLOCK || error == EALREADY; }
+        static bool alreadyConnected(int error) noexcept { return error == EISCONN; }
+        static bool notConnected(int error) noexcept { return error == ENOTCONN; }
+        static bool interrupted(int error) noexcept { return error == EINTR; }
+        static bool aborted(int error) noexcept { return error == ECONNABORTED; }
+
+        static bool connectionLost(int error) noexcept
+        {
+            return error == ECONNRESET || error == EPIPE || error == ENOTCONN;
+        }
+
+        static bool setNonBlocking(Handle fd, bool enable) noexcept
+        {
+            int flags = ::fcntl(fd, F_GETFL, 0);
+            if(flags < 0) return false;
+            flags = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+            return ::fcntl(fd, F_SETFL, flags) >= 0;
+        }
+
+        static int poll(PollDescriptor* fds, size_t count, int timeoutMs) noexcept
+        {
+            return ::poll(fds, static_cast<nfds_t>(count), timeoutMs);
+        }
+
+        static ptrdiff_t send(Handle fd, void const * data, size_t size, int flags) noexcept
+        {
+            return ::send(fd, data, size, flags);
+        }
+
+        static ptrdiff_t recv(Handle fd, void * data, size_t size, int flags) noexcept
+        {
+            return ::recv(fd, data, size, flags);
+        }
+
+        static ptrdiff_t sendTo(Handle fd, void const * data, size_t size, int flags, sockaddr const * addr, Length length) noexcept
+        {
+            return ::sendto(fd, data, size, flags, addr, length);
+        }
+
+        static ptrdiff_t recvFrom(Handle fd, void * data, size_t size, int flags, sockaddr* addr, Length* length) noexcept
+        {
+            return ::recvfrom(fd, data, size, flags, addr, length);
+        }
+
+        template<typename T>
+        static bool setOption(Handle fd, int level, int name, T const & value) noexcept
+        {
+            return ::setsockopt(fd, level, name, &value, sizeof(value)) == 0;
+        }
+
+        template<typename T>
+        static bool getOption(Handle fd, int level, int name, T& value) noexcept
+        {
+            Length size = sizeof(value);
+            return ::getsockopt(fd, level, name, &value, &size) == 0;
+        }
+    };
+#endif
+}
\ No newline at end of file
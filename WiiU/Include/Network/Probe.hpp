@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "Network/Platform.hpp"
+#include "Network/Statistics.hpp"
+
+namespace Library::Network
+{
+    namespace Detail
+    {
+        extern std::atomic<bool> statisticsEnabled;
+
+        void record(Metric metric, int64_t res, size_t bytes, int error, std::chrono::nanoseconds elapsed) noexcept;
+    }
+
+    // Times one syscall and files its outcome under a metric while statistics are
+    // enabled. Wrap only the syscall itself so the histogram shows kernel time.
+    class Probe
+    {
+    public:
+        explicit Probe(Metric metric) noexcept :
+            metric(metric),
+            active(Detail::statisticsEnabled.load(std::memory_order_relaxed))
+        {
+            if(active) start = Clock::now();
+        }
+
+        // res is the syscall's return value; on failure the last error is read and preserved.
+        void done(int64_t res) noexcept
+        {
+            done(res, res > 0 ? static_cast<size_t>(res) : 0);
+        }
+
+        void done(int64_t res, size_t bytes) noexcept
+        {
+            if(!active) return;
+
+            int error = Platform::lastError();
+            Detail::record(metric, res, bytes, res < 0 ? error : 0, Clock::now() - start);
+            Platform::setLastError(error);
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Metric metric;
+        bool active;
+        Clock::time_point start;
+    };
+}
\ No newline at end of file
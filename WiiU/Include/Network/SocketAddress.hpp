@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Network/Endpoint.hpp"
+#include "Network/Platform.hpp"
+
+#include <cstring>
+
+namespace Library::Network
+{
+    // Native sockaddr; storage is large enough for every family the stack can return.
+    struct SocketAddress
+    {
+        union
+        {
+            sockaddr base;
+            sockaddr_in v4;
+#if defined(NETWORK_HAS_IPV6)
+            sockaddr_in6 v6;
+#endif
+            sockaddr_storage storage;
+        };
+        Platform::Length length;
+
+        sockaddr* data() noexcept { return &base; }
+        sockaddr const * data() const noexcept { return &base; }
+
+        static constexpr Platform::Length capacity() noexcept
+        {
+            return sizeof(sockaddr_storage);
+        }
+    };
+
+    // Returns AddressFamily::None when the family is not supported on this platform.
+    inline AddressFamily toAddressFamily(int family) noexcept
+    {
+        if(family == AF_INET) return AddressFamily::IPv4;
+#if defined(NETWORK_HAS_IPV6)
+        if(family == AF_INET6) return AddressFamily::IPv6;
+#endif
+        return AddressFamily::None;
+    }
+
+    // socketFamily is the family of the socket the address is for. An IPv4 endpoint
+    // on an IPv6 (dual-stack) socket becomes its v4-mapped form, ::ffff:a.b.c.d.
+    // Returns false when the family is not supported on this platform.
+    inline bool toSocketAddress(Endpoint const & endpoint, SocketAddress& out, AddressFamily socketFamily = AddressFamily::None) noexcept
+    {
+        switch(endpoint.family())
+        {
+        case AddressFamily::IPv4:
+#if defined(NETWORK_HAS_IPV6)
+            if(socketFamily == AddressFamily::IPv6)
+            {
+                std::memset(&out.v6, 0, sizeof(out.v6));
+                out.v6.sin6_family = AF_INET6;
+                uint8_t* bytes = reinterpret_cast<uint8_t*>(&out.v6.sin6_addr);
+                bytes[10] = 0xFF;
+                bytes[11] = 0xFF;
+                std::memcpy(bytes + 12, endpoint.bytes().data(), 4);
+                out.v6.sin6_port = htons(endpoint.port());
+                out.length = sizeof(out.v6);
+                return true;
+            }
+#endif
+            std::memset(&out.v4, 0, sizeof(out.v4));
+            out.v4.sin_family = AF_INET;
+            std::memcpy(&out.v4.sin_addr, endpoint.bytes().data(), 4);
+            out.v4.sin_port = htons(endpoint.port());
+            out.length = sizeof(out.v4);
+            return true;
+#if defined(NETWORK_HAS_IPV6)
+        case AddressFamily::IPv6:
+            std::memset(&out.v6, 0, sizeof(out.v6));
+            out.v6.sin6_family = AF_INET6;
+            std::memcpy(&out.v6.sin6_addr, endpoint.bytes().data(), 16);
+            out.v6.sin6_port = htons(endpoint.port());
+            out.v6.sin6_scope_id = endpoint.scopeId();
+            out.length = sizeof(out.v6);
+            return true;
+#endif
+        default:
+            (void)socketFamily;
+            return false;
+        }
+    }
+
+    // v4-mapped addresses come back as IPv4, so a peer compares equal whether it
+    // reached an IPv4 socket or a dual-stack one.
+    inline Endpoint fromSocketAddress(sockaddr const * addr, Platform::Length length) noexcept
+    {
+        if(addr->sa_family == AF_INET && length >= static_cast<Platform::Length>(sizeof(sockaddr_in)))
+        {
+            sockaddr_in const * v4 = reinterpret_cast<sockaddr_in const *>(addr);
+            return Endpoint::ipv4(ntohl(v4->sin_addr.s_addr), ntohs(v4->sin_port));
+        }
+#if defined(NETWORK_HAS_IPV6)
+        if(addr->sa_family == AF_INET6 && length >= static_cast<Platform::Length>(sizeof(sockaddr_in6)))
+        {
+            sockaddr_in6 const * v6 = reinterpret_cast<sockaddr_in6 const *>(addr);
+            Endpoint::Bytes bytes;
+            std::memcpy(bytes.data(), &v6->sin6_addr, 16);
+
+            constexpr uint8_t MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+            if(std::memcmp(bytes.data(), MappedPrefix, sizeof(MappedPrefix)) == 0)
+            {
+                uint32_t address = (static_cast<uint32_t>(bytes[12]) << 24) | (static_cast<uint32_t>(bytes[13]) << 16) |
+                                   (static_cast<uint32_t>(bytes[14]) << 8) | static_cast<uint32_t>(bytes[15]);
+                return Endpoint::ipv4(address, ntohs(v6->sin6_port));
+            }
+
+            return Endpoint::ipv6(bytes, ntohs(v6->sin6_port), v6->sin6_scope_id);
+        }
+#endif
+        return Endpoint();
+    }
+
+    inline Endpoint fromSocketAddress(SocketAddress const & addr) noexcept
+    {
+        return fromSocketAddress(addr.data(), addr.length);
+    }
+
+    inline Endpoint localEndpoint(SocketFD fd) noexcept
+    {
+        SocketAddress addr;
+        addr.length = SocketAddress::capacity();
+        if(::getsockname(fd, addr.data(), &addr.length) < 0) return Endpoint();
+        return fromSocketAddress(addr);
+    }
+
+    // The socket's own family, which getsockname reports even before bind.
+    inline AddressFamily socketFamily(SocketFD fd) noexcept
+    {
+        SocketAddress addr;
+        addr.length = SocketAddress::capacity();
+        if(::getsockname(fd, addr.data(), &addr.length) < 0) return AddressFamily::None;
+        return toAddressFamily(addr.base.sa_family);
+    }
+
+#if defined(__linux__)
+    // Room for the destination control message either family can deliver.
+    constexpr size_t DestinationControl = CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(in_pktinfo));
+
+    // Sets IP_PKTINFO (and IPV6_RECVPKTINFO on IPv6 sockets, where a dual-stack socket
+    // still reports IPv4 traffic through IP_PKTINFO), so reads can tell the address
+    // a datagram was sent to.
+    inline bool receiveDestination(SocketFD fd, AddressFamily family) noexcept
+    {
+        int opt = 1;
+        bool v4 = Platform::setOption(fd, IPPROTO_IP, IP_PKTINFO, opt);
+        if(family != AddressFamily::IPv6) return v4;
+        return Platform::setOption(fd, IPPROTO_IPV6, IPV6_RECVPKTINFO, opt);
+    }
+
+    // The destination address from a received message's control data, port 0; an
+    // empty Endpoint when the message has none.
+    inline Endpoint destinationAddress(msghdr const & msg) noexcept
+    {
+        for(cmsghdr const * cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&msg), const_cast<cmsghdr*>(cmsg)))
+        {
+            if(cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+            {
+                in_pktinfo info;
+                std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                return Endpoint::ipv4(ntohl(info.ipi_addr.s_addr), 0);
+            }
+            if(cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
+            {
+                in6_pktinfo info;
+                std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+
+                sockaddr_in6 addr{};
+                addr.sin6_family = AF_INET6;
+                addr.sin6_addr = info.ipi6_addr;
+                return fromSocketAddress(reinterpret_cast<sockaddr const *>(&addr), sizeof(addr));
+            }
+        }
+        return Endpoint();
+    }
+#endif
+
+    // Opens a socket of the given family with the address reuse option set. IPv6
+    // sockets get IPV6_V6ONLY set explicitly (the defaults differ between Linux and
+    // Windows); dualStack clears it so the socket also carries IPv4 traffic.
+    // Returns Platform::Invalid with the last error set on failure.
+    inline SocketFD openSocket(AddressFamily family, int type, int protocol, bool dualStack) noexcept
+    {
+        int domain;
+        switch(family)
+        {
+        case AddressFamily::IPv4:
+            domain = AF_INET;
+            break;
+#if defined(NETWORK_HAS_IPV6)
+        case AddressFamily::IPv6:
+            domain = AF_INET6;
+            break;
+#endif
+        default:
+            Platform::setLastError(Platform::FamilyUnsupported);
+            return Platform::Invalid;
+        }
+
+        SocketFD fd = ::socket(domain, type, protocol);
+        if(!Platform::valid(fd)) return fd;
+
+        int opt = 1;
+        bool configured = Platform::setOption(fd, SOL_SOCKET, Platform::ReuseAddress, opt);
+#if defined(NETWORK_HAS_IPV6)
+        int only = dualStack ? 0 : 1;
+        if(configured && domain == AF_INET6) configured = Platform::setOption(fd, IPPROTO_IPV6, IPV6_V6ONLY, only);
+#else
+        (void)dualStack;
+#endif
+        if(configured) return fd;
+
+        int error = Platform::lastError();
+        Platform::close(fd);
+        Platform::setLastError(error);
+        return Platform::Invalid;
+    }
+}
\ No newline at end of file
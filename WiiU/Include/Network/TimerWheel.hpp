@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Library::Network
+{
+    // Hierarchical timing wheel with millisecond ticks: four levels of 256 slots
+    // cover 2^32 ms (~49 days), longer timers park in the top level and are re-filed
+    // when it comes round. Timers live in a slab and each slot is an intrusive list,
+    // so add, cancel and rearm are O(1) and allocation free once the slab is warm.
+    // Timers in the upper levels move down a level when their slot comes due, i.e.
+    // each timer is touched at most once per level. Not thread-safe.
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimerId = uint64_t;   // never 0
+
+        explicit TimerWheel(Clock::time_point origin) noexcept;
+
+        TimerId add(Clock::time_point now, std::chrono::milliseconds delay, std::function<void()> job);
+        bool cancel(TimerId id) noexcept;
+        bool rearm(TimerId id, Clock::time_point now, std::chrono::milliseconds delay) noexcept;
+
+        // Milliseconds from now until the next expiry (or the next cascade, which is
+        // never later than the expiries it feeds); -1 without timers.
+        int64_t timeout(Clock::time_point now) const noexcept;
+
+        // Moves the jobs of every timer due at now into jobs, earliest slot first.
+        void expire(Clock::time_point now, std::vector<std::function<void()>>& jobs);
+
+        size_t size() const noexcept;
+
+    private:
+        static constexpr unsigned Levels = 4;
+        static constexpr unsigned SlotBits = 8;
+        static constexpr unsigned Slots = 1u << SlotBits;
+        static constexpr uint64_t SlotMask = Slots - 1;
+        static constexpr uint32_t Nil = 0xFFFFFFFFu;
+        static constexpr uint16_t Due = Levels * Slots;     // already expired, fires next pass
+        static constexpr uint16_t Unlinked = 0xFFFF;
+
+        struct Node
+        {
+            std::function<void()> job;
+            uint64_t deadline = 0;
+            uint32_t prev = Nil;
+            uint32_t next = Nil;
+            uint32_t generation = 0;
+            uint16_t bucket = Unlinked;
+        };
+
+        uint64_t nextTick() const noexcept;
+        uint64_t tick(Clock::time_point now) const noexcept;
+        uint64_t deadline(Clock::time_point now, std::chrono::milliseconds delay) const noexcept;
+        uint32_t find(TimerId id) const noexcept;   // Nil for stale ids
+
+        void file(uint32_t index) noexcept;
+        void link(uint32_t index, uint16_t bucket) noexcept;
+        void unlink(uint32_t index) noexcept;
+        void release(uint32_t index) noexcept;
+        void cascade() noexcept;
+        void drain(uint16_t bucket, std::vector<std::function<void()>>& jobs);
+
+        // Distance from slot from to the first occupied slot of a level, wrapping
+        // around; Slots when the level is empty.
+        unsigned nextSlot(unsigned level, unsigned from) const noexcept;
+
+        Clock::time_point origin;
+        uint64_t current;   // every timer with deadline <= current has fired
+        size_t active;
+
+        std::vector<Node> nodes;
+        uint32_t freeList;
+
+        std::array<uint32_t, Levels * Slots + 1> heads;
+        std::array<std::array<uint64_t, Slots / 64>, Levels> occupied;
+    };
+}
\ No newline at end of file
@@ -1,8 +1,22 @@
 #pragma once
 
+#include "Network/AsyncTcpSocket.hpp"
+#include "Network/BufferedTcpStream.hpp"
+#include "Network/BufferPool.hpp"
+#include "Network/CompletionEngine.hpp"
+#include "Network/ConnectionPool.hpp"
+#include "Network/EventLoop.hpp"
+#include "Network/FrameCodec.hpp"
+#include "Network/ReliableUdpSession.hpp"
+#include "Network/Resolver.hpp"
 #include "Network/Result.hpp"
+#include "Network/SocketOptions.hpp"
+#include "Network/Statistics.hpp"
+#include "Network/Task.hpp"
+#include "Network/TcpServer.hpp"
 #include "Network/TcpSocket.hpp"
 #include "Network/UdpSocket.hpp"
+#include "Network/ZeroCopySender.hpp"
 
 namespace Library::Network
 {
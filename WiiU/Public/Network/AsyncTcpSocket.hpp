@@ -0,0 +1,145 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include "Network/Endpoint.hpp"
+#include "Network/EventLoop.hpp"
+#include "Network/Result.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    // Coroutine front end for a non-blocking TcpSocket on an EventLoop. Each operation
+    // is tried at once and only suspends on WouldBlock; the coroutine is resumed from
+    // the loop when the socket becomes ready, so a connection reads as straight-line
+    // code without a thread of its own. At most one reader and one writer may be
+    // suspended at a time, and the socket must outlive them.
+    class AsyncTcpSocket
+    {
+        struct State;
+
+        struct Waiter
+        {
+            virtual bool attempt() noexcept = 0;   // true once the operation has finished
+            virtual void expire() noexcept = 0;    // deadline passed before that
+
+            std::coroutine_handle<> handle;
+            EventLoop::TimerId timer = 0;
+
+        protected:
+            ~Waiter() = default;
+        };
+
+    public:
+        // Data: bytes received (at least one). WouldBlock: timed out.
+        class RecvAwaiter : private Waiter
+        {
+        public:
+            bool await_ready() noexcept;
+            bool await_suspend(std::coroutine_handle<> handle);
+            Result await_resume() const noexcept { return result; }
+
+        private:
+            friend class AsyncTcpSocket;
+            RecvAwaiter(State* state, void* data, size_t size, int timeoutMs) noexcept;
+
+            bool attempt() noexcept override;
+            void expire() noexcept override;
+
+            State* state;
+            void* data;
+            size_t size;
+            int timeoutMs;
+            Result result;
+        };
+
+        // Sends the whole buffer. bytes counts what went out even when the result is
+        // Disconnected, Error or WouldBlock (timed out).
+        class SendAwaiter : private Waiter
+        {
+        public:
+            bool await_ready() noexcept;
+            bool await_suspend(std::coroutine_handle<> handle);
+            Result await_resume() const noexcept { return result; }
+
+        private:
+            friend class AsyncTcpSocket;
+            SendAwaiter(State* state, void const * data, size_t size, int timeoutMs) noexcept;
+
+            bool attempt() noexcept override;
+            void expire() noexcept override;
+
+            State* state;
+            void const * data;
+            size_t size;
+            size_t sent;
+            int timeoutMs;
+            Result result;
+        };
+
+        class ConnectAwaiter : private Waiter
+        {
+        public:
+            bool await_ready() noexcept;
+            bool await_suspend(std::coroutine_handle<> handle);
+            bool await_resume() const noexcept { return connected; }
+
+        private:
+            friend class AsyncTcpSocket;
+            ConnectAwaiter(State* state, Endpoint const & endpoint, int timeoutMs) noexcept;
+
+            bool attempt() noexcept override;
+            void expire() noexcept override;
+
+            State* state;
+            Endpoint endpoint;
+            int timeoutMs;
+            bool connected;
+        };
+
+        // Empty when the listener failed; the accepted socket shares the listener's loop.
+        class AcceptAwaiter : private Waiter
+        {
+        public:
+            bool await_ready() noexcept;
+            bool await_suspend(std::coroutine_handle<> handle);
+            std::optional<AsyncTcpSocket> await_resume();
+
+        private:
+            friend class AsyncTcpSocket;
+            explicit AcceptAwaiter(State* state) noexcept;
+
+            bool attempt() noexcept override;
+            void expire() noexcept override;
+
+            State* state;
+            std::optional<TcpSocket> accepted;
+        };
+
+        explicit AsyncTcpSocket(EventLoop& loop);
+        AsyncTcpSocket(EventLoop& loop, TcpSocket socket);
+        ~AsyncTcpSocket() noexcept;
+
+        AsyncTcpSocket(const AsyncTcpSocket&) = delete;
+        AsyncTcpSocket& operator=(const AsyncTcpSocket&) = delete;
+
+        AsyncTcpSocket(AsyncTcpSocket&& other) noexcept;
+        AsyncTcpSocket& operator=(AsyncTcpSocket&& other) noexcept;
+
+        bool listen(uint16_t port, int backlog = 1024);
+
+        AcceptAwaiter accept() noexcept;
+        ConnectAwaiter connect(Endpoint const & endpoint, int timeoutMs = -1) noexcept;
+        RecvAwaiter recv(void* data, size_t size, int timeoutMs = -1) noexcept;
+        SendAwaiter send(void const * data, size_t size, int timeoutMs = -1) noexcept;
+
+        TcpSocket& socket() noexcept;
+        EventLoop& loop() noexcept;
+
+    private:
+        std::unique_ptr<State> state;
+    };
+}
\ No newline at end of file
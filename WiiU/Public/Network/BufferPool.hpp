@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace Library::Network
+{
+    struct BufferChunk;
+    struct BufferArena;
+
+    // Reference-counted view into a pooled chunk. Copies and slices share the chunk,
+    // which returns to its pool when the last handle goes away. Bytes [data, data + size)
+    // are valid; [data + size, data + capacity) is free space for receives to fill.
+    class Buffer
+    {
+    public:
+        Buffer() noexcept = default;
+        ~Buffer() noexcept;
+
+        Buffer(const Buffer& other) noexcept;
+        Buffer& operator=(const Buffer& other) noexcept;
+
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(Buffer&& other) noexcept;
+
+        std::byte* data() noexcept { return bytes; }
+        std::byte const * data() const noexcept { return bytes; }
+        size_t size() const noexcept { return length; }
+        size_t capacity() const noexcept { return room; }
+        bool empty() const noexcept { return length == 0; }
+        explicit operator bool() const noexcept { return chunk != nullptr; }
+
+        // Shares the chunk; no bytes are copied.
+        Buffer slice(size_t offset, size_t count) const noexcept;
+
+        // Grows or shrinks the valid range within capacity().
+        void resize(size_t count) noexcept;
+
+        // Drops count bytes from the front, e.g. after a partial send.
+        void consume(size_t count) noexcept;
+
+        uint32_t useCount() const noexcept;
+        void reset() noexcept;
+
+    private:
+        friend class BufferPool;
+
+        Buffer(BufferChunk* chunk, std::byte* bytes, size_t length, size_t room) noexcept;
+
+        BufferChunk* chunk = nullptr;
+        std::byte* bytes = nullptr;
+        size_t length = 0;
+        size_t room = 0;
+    };
+
+    // Fixed-size chunks carved out of slabs, with a small per-thread cache in front of
+    // a shared free list so acquire/release rarely touch the lock. Memory is bounded
+    // by maxChunks; acquire() returns an empty handle once the pool is exhausted, and a
+    // thread's cache may hold up to 64 free chunks that other threads cannot see.
+    // The pool must outlive every Buffer it hands out.
+    class BufferPool
+    {
+    public:
+        BufferPool(size_t chunkSize, size_t maxChunks, size_t chunksPerSlab = 64);
+        ~BufferPool() noexcept;
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        Buffer acquire() noexcept;
+
+        size_t chunkSize() const noexcept;
+        size_t maxChunks() const noexcept;
+        size_t allocatedChunks() const noexcept;
+
+    private:
+        std::shared_ptr<BufferArena> arena;
+    };
+}
\ No newline at end of file
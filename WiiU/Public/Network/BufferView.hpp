@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Library::Network
+{
+    struct ConstBufferView
+    {
+        void const * data;
+        size_t size;
+    };
+
+    struct MutableBufferView
+    {
+        void * data;
+        size_t size;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "Network/EventLoop.hpp"
+#include "Network/Result.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    // Coalesces small writes into a growable ring and drains it with one vectored send,
+    // and keeps a read-ahead buffer for line and fixed-size reads. Queued bytes go out
+    // when they reach flushThreshold, on flush(), or at the end of the current loop
+    // iteration when a loop is attached. With a loop, a flush that would block resumes
+    // once the socket is writable: the stream registers the socket for Event::Write
+    // until the queue drains or, when the socket is already in the loop, adds Write to
+    // its interest, and the owner's callback calls flush() on Event::Write.
+    class BufferedTcpStream
+    {
+    public:
+        struct Config
+        {
+            size_t flushThreshold = 16 * 1024;
+            size_t maxQueued = 4 * 1024 * 1024;
+            size_t readAhead = 16 * 1024;
+            size_t maxLine = 64 * 1024;
+            EventLoop* loop = nullptr;     // the stream is then used on the loop's thread only
+        };
+
+        explicit BufferedTcpStream(TcpSocket socket);
+        BufferedTcpStream(TcpSocket socket, Config config);
+        ~BufferedTcpStream() noexcept;
+
+        BufferedTcpStream(const BufferedTcpStream&) = delete;
+        BufferedTcpStream& operator=(const BufferedTcpStream&) = delete;
+
+        BufferedTcpStream(BufferedTcpStream&& other) noexcept;
+        BufferedTcpStream& operator=(BufferedTcpStream&& other) noexcept;
+
+        TcpSocket& socket() noexcept;
+
+        // Queues the bytes (or sends them directly when nothing is queued and they are
+        // large). WouldBlock means the queue limit was hit and nothing was taken.
+        Result write(void const * data, size_t size);
+        Result flush() noexcept;
+        size_t pending() const noexcept;
+
+        // Holds partial segments in the kernel until uncorked (TCP_CORK on Linux).
+        bool cork(bool enable) noexcept;
+
+        // Reads from the read-ahead buffer first, then the socket.
+        Result read(void * data, size_t size) noexcept;
+
+        // Data once all size bytes are available; WouldBlock consumes nothing.
+        Result readExact(void * data, size_t size) noexcept;
+
+        // Line without its "\n" or "\r\n", valid until the next read call. Error when a
+        // line exceeds maxLine.
+        Result readLine(std::string_view& line) noexcept;
+
+        size_t buffered() const noexcept;
+
+    private:
+        Result fill() noexcept;
+        // How the stream waits for writability after a blocked flush.
+        enum class Watch : uint8_t
+        {
+            None,
+            Owned,      // the stream's own registration
+            Shared      // Write added to the owner's registration
+        };
+
+        void scheduleFlush();
+        void watchWritable() noexcept;
+        void unwatchWritable() noexcept;
+        void grow(size_t required);
+        void enqueue(std::byte const * data, size_t size) noexcept;
+
+        TcpSocket stream;
+        Config config;
+
+        std::vector<std::byte> ring;
+        size_t head;
+        size_t queued;
+        bool flushScheduled;
+        Watch watch;
+
+        std::vector<std::byte> input;
+        size_t readPos;
+        size_t readEnd;
+
+        // Deferred flushes and the write watch reach the stream through this, so they
+        // survive moves and become no-ops once the stream is gone.
+        std::shared_ptr<BufferedTcpStream*> self;
+    };
+}
\ No newline at end of file
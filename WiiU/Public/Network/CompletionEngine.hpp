@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include "Network/BufferView.hpp"
+#include "Network/Define.hpp"
+#include "Network/Endpoint.hpp"
+#include "Network/EventLoop.hpp"
+#include "Network/Result.hpp"
+
+namespace Library::Network
+{
+    // Completion-style I/O backed by io_uring on Linux, next to the readiness-style
+    // EventLoop. Operations are queued into the submission ring and submitted together
+    // by run()/submit(), so many sends, receives and accepts cost one syscall. Buffers
+    // passed to an operation must stay valid until its completion is delivered.
+    // Sockets should be in blocking mode: for non-blocking ones the kernel completes
+    // with WouldBlock instead of waiting.
+    class CompletionEngine
+    {
+    public:
+        enum class Operation : uint8_t
+        {
+            Send,
+            Recv,
+            SendTo,
+            RecvFrom,
+            Accept,
+            Poll,
+            SendFixed,
+            RecvFixed,
+            Cancel
+        };
+
+        // A socket descriptor, or an index into the files registered with registerFiles().
+        struct Target
+        {
+            Target(SocketFD fd) noexcept : value(fd), fixed(false) {}
+
+            static Target registered(unsigned index) noexcept
+            {
+                Target target(static_cast<SocketFD>(index));
+                target.fixed = true;
+                return target;
+            }
+
+            SocketFD value;
+            bool fixed;
+        };
+
+        struct Completion
+        {
+            uint64_t userData;
+            Operation operation;
+            Result result;
+            SocketFD accepted = -1;         // Accept: new blocking socket (see TcpSocket::adopt)
+            Endpoint peer;                  // RecvFrom: sender
+            std::byte* buffer = nullptr;    // multishot recv: provided buffer, recycle() when done
+            uint16_t bufferId = 0;
+            Event events = Event::None;     // Poll
+            bool more = false;              // multishot: further completions will follow
+        };
+
+        using Handler = std::function<void(Completion const &)>;
+
+        struct Config
+        {
+            unsigned entries = 256;
+            unsigned maxOperations = 1024;
+        };
+
+        // Throws std::system_error when io_uring is unavailable.
+        CompletionEngine();
+        explicit CompletionEngine(Config config);
+        ~CompletionEngine() noexcept;
+
+        CompletionEngine(const CompletionEngine&) = delete;
+        CompletionEngine& operator=(const CompletionEngine&) = delete;
+
+        static bool supported() noexcept;
+
+        // Queue operations; false when the operation table or submission ring is full.
+        bool send(Target target, void const * data, size_t size, uint64_t userData) noexcept;
+        bool recv(Target target, void * data, size_t size, uint64_t userData) noexcept;
+        bool sendTo(Target target, Endpoint const & peer, void const * data, size_t size, uint64_t userData) noexcept;
+        bool recvFrom(Target target, void * data, size_t size, uint64_t userData) noexcept;
+        bool accept(Target target, uint64_t userData, bool multishot = false) noexcept;
+        bool recvMultishot(Target target, uint16_t group, uint64_t userData) noexcept;
+        bool poll(Target target, Event interest, uint64_t userData) noexcept;
+
+        // Operate on a registered buffer. sendFixed sends with MSG_NOSIGNAL like send,
+        // zero-copy from the registered pages where IORING_OP_SEND_ZC exists (Linux 6.0)
+        // and then completes once the kernel no longer reads them; on older kernels it is
+        // a plain send of the same bytes. recvFixed reads, which never raises SIGPIPE.
+        bool sendFixed(Target target, unsigned bufferIndex, size_t offset, size_t size, uint64_t userData) noexcept;
+        bool recvFixed(Target target, unsigned bufferIndex, size_t offset, size_t size, uint64_t userData) noexcept;
+        bool cancel(uint64_t userData) noexcept;
+
+        // Registered buffers and files skip per-operation page pinning and fd lookup.
+        bool registerBuffers(std::span<MutableBufferView const> buffers) noexcept;
+        bool registerFiles(std::span<SocketFD const> fds) noexcept;
+
+        // Kernel-selected receive buffers for recvMultishot; count must be a power of two.
+        bool provideBuffers(uint16_t group, uint16_t count, size_t size) noexcept;
+        void recycle(uint16_t group, uint16_t bufferId) noexcept;
+
+        size_t submit() noexcept;
+
+        // Submits queued operations, waits up to timeoutMs (-1: forever) for at least one
+        // completion and delivers every available completion to handler.
+        size_t run(int timeoutMs, Handler const & handler);
+
+        size_t inFlight() const noexcept;
+
+        // The ring descriptor is readable while completions are pending.
+        SocketFD native() const noexcept;
+
+    private:
+        struct Ring;
+        std::unique_ptr<Ring> ring;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "Network/Endpoint.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    class ConnectionPool;
+
+    // Exclusive use of one pooled connection. Going out of scope hands the socket back
+    // for reuse; call discard() instead when the connection is in an unknown state
+    // (protocol error, Disconnected, half-read response).
+    class Lease
+    {
+    public:
+        Lease() noexcept;
+        ~Lease() noexcept;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        TcpSocket& socket() noexcept { return *connection; }
+        TcpSocket* operator->() noexcept { return &*connection; }
+        explicit operator bool() const noexcept { return connection.has_value(); }
+
+        Endpoint const & endpoint() const noexcept { return peer; }
+
+        // True when the connection came from the idle list rather than a new connect.
+        bool reused() const noexcept { return warm; }
+
+        void discard() noexcept;
+        void release() noexcept;
+
+    private:
+        friend class ConnectionPool;
+
+        Lease(ConnectionPool* pool, Endpoint const & peer, TcpSocket socket, bool warm) noexcept;
+
+        ConnectionPool* pool;
+        Endpoint peer;
+        std::optional<TcpSocket> connection;
+        bool warm;
+    };
+
+    // Keeps connections to backends open between requests so each request skips the
+    // handshake. Idle connections are reused most recently used first, checked before
+    // they are handed out and closed once idle for longer than idleTimeout. Thread-safe;
+    // the pool must outlive every Lease it hands out.
+    class ConnectionPool
+    {
+    public:
+        struct Config
+        {
+            size_t maxPerHost = 8;                  // leased (and connecting) at once
+            size_t maxIdlePerHost = 8;
+            std::chrono::milliseconds idleTimeout{60000};
+            int connectTimeoutMs = 3000;
+            SocketOptions options;                  // applied to each new socket before it connects
+        };
+
+        ConnectionPool();
+        explicit ConnectionPool(Config config);
+        ~ConnectionPool() noexcept;
+
+        ConnectionPool(const ConnectionPool&) = delete;
+        ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+        // A healthy idle connection, otherwise a new one. At the per-host limit waits
+        // up to waitMs (-1: forever) for a lease to come back. Empty on timeout or when
+        // the connect fails.
+        Lease acquire(Endpoint const & endpoint, int waitMs = 0);
+
+        // Idle connections only; never connects or waits.
+        Lease tryAcquire(Endpoint const & endpoint);
+
+        size_t idle(Endpoint const & endpoint) const;
+        size_t leased(Endpoint const & endpoint) const;
+
+        // Closes idle connections that timed out or went stale.
+        size_t prune();
+        void clear();
+
+    private:
+        friend class Lease;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Idle
+        {
+            TcpSocket socket;
+            Clock::time_point since;
+        };
+
+        struct Host
+        {
+            std::vector<Idle> idle;
+            size_t leased = 0;
+            size_t waiters = 0;     // acquire() calls blocked on this host; keep it alive
+        };
+
+        std::optional<TcpSocket> takeIdle(Host& host);
+        void giveBack(Endpoint const & endpoint, std::optional<TcpSocket> socket) noexcept;
+        static bool healthy(TcpSocket& socket) noexcept;
+
+        Config config;
+
+        mutable std::mutex mutex;
+        std::condition_variable returned;
+        std::unordered_map<Endpoint, Host> hosts;
+    };
+}
\ No newline at end of file
@@ -1,6 +1,14 @@
 #pragma once
 
+#if defined(_WIN32)
+#include <winsock2.h>
+#endif
+
 namespace Library::Network
 {
+#if defined(_WIN32)
+    using SocketFD = SOCKET;
+#else
     using SocketFD = int;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Library::Network
+{
+    enum class AddressFamily : uint8_t
+    {
+        None,
+        IPv4,
+        IPv6
+    };
+
+    // Binary IPv4/IPv6 address and port. Trivially copyable, so the per-packet paths
+    // pass it around without formatting, parsing or allocating.
+    class Endpoint
+    {
+    public:
+        using Bytes = std::array<uint8_t, 16>;
+
+        constexpr Endpoint() noexcept = default;
+
+        // address in host byte order, e.g. 0x7F000001 for 127.0.0.1
+        static constexpr Endpoint ipv4(uint32_t address, uint16_t port) noexcept
+        {
+            Endpoint endpoint;
+            endpoint.addressBytes[0] = static_cast<uint8_t>(address >> 24);
+            endpoint.addressBytes[1] = static_cast<uint8_t>(address >> 16);
+            endpoint.addressBytes[2] = static_cast<uint8_t>(address >> 8);
+            endpoint.addressBytes[3] = static_cast<uint8_t>(address);
+            endpoint.portNumber = port;
+            endpoint.addressFamily = AddressFamily::IPv4;
+            return endpoint;
+        }
+
+        // address in network byte order
+        static constexpr Endpoint ipv6(Bytes const & address, uint16_t port, uint32_t scopeId = 0) noexcept
+        {
+            Endpoint endpoint;
+            endpoint.addressBytes = address;
+            endpoint.scope = scopeId;
+            endpoint.portNumber = port;
+            endpoint.addressFamily = AddressFamily::IPv6;
+            return endpoint;
+        }
+
+        // Wildcard address of the family, for listening on every interface.
+        static constexpr Endpoint any(AddressFamily family, uint16_t port) noexcept
+        {
+            return family == AddressFamily::IPv6 ? ipv6(Bytes{}, port) : ipv4(0, port);
+        }
+
+        // Numeric addresses only ("192.168.0.1", "::1", "fe80::1%eth0"); no name resolution.
+        static std::optional<Endpoint> parse(std::string_view host, uint16_t port) noexcept;
+
+        constexpr AddressFamily family() const noexcept { return addressFamily; }
+        constexpr uint16_t port() const noexcept { return portNumber; }
+        constexpr uint32_t scopeId() const noexcept { return scope; }
+        constexpr Bytes const & bytes() const noexcept { return addressBytes; }
+
+        constexpr uint32_t ipv4Address() const noexcept
+        {
+            return (static_cast<uint32_t>(addressBytes[0]) << 24) |
+                   (static_cast<uint32_t>(addressBytes[1]) << 16) |
+                   (static_cast<uint32_t>(addressBytes[2]) << 8) |
+                    static_cast<uint32_t>(addressBytes[3]);
+        }
+
+        constexpr Endpoint withPort(uint16_t port) const noexcept
+        {
+            Endpoint endpoint = *this;
+            endpoint.portNumber = port;
+            return endpoint;
+        }
+
+        std::string address() const;
+        std::string toString() const;
+
+        size_t hash() const noexcept;
+
+        constexpr bool operator==(Endpoint const &) const noexcept = default;
+        constexpr auto operator<=>(Endpoint const &) const noexcept = default;
+
+    private:
+        AddressFamily addressFamily = AddressFamily::None;
+        Bytes addressBytes{};
+        uint16_t portNumber = 0;
+        uint32_t scope = 0;
+    };
+}
+
+template<>
+struct std::hash<Library::Network::Endpoint>
+{
+    size_t operator()(Library::Network::Endpoint const & endpoint) const noexcept
+    {
+        return endpoint.hash();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Network/Define.hpp"
+
+namespace Library::Network
+{
+    class TimerWheel;
+
+    // Interest and readiness flags. Read/Write are used both when registering and
+    // when reporting; Error/Hangup are only ever reported.
+    enum class Event : uint8_t
+    {
+        None = 0,
+        Read = 1 << 0,
+        Write = 1 << 1,
+        Error = 1 << 2,
+        Hangup = 1 << 3
+    };
+
+    constexpr Event operator|(Event a, Event b) noexcept
+    {
+        return static_cast<Event>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+    }
+
+    constexpr Event operator&(Event a, Event b) noexcept
+    {
+        return static_cast<Event>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+    }
+
+    constexpr bool has(Event set, Event flag) noexcept
+    {
+        return (set & flag) != Event::None;
+    }
+
+    // Level-triggered readiness multiplexer. One wait syscall per iteration services
+    // every registered socket; callbacks run on the thread calling run()/runOnce().
+    class EventLoop
+    {
+    public:
+        enum class Backend
+        {
+            Default,
+            Epoll,
+            Poll
+        };
+
+        using Callback = std::function<void(Event)>;
+        using TimerId = uint64_t;
+
+        explicit EventLoop(Backend backend = Backend::Default);
+        ~EventLoop() noexcept;
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        bool add(SocketFD fd, Event interest, Callback callback);
+        bool modify(SocketFD fd, Event interest) noexcept;
+        bool remove(SocketFD fd);
+        bool contains(SocketFD fd) const noexcept;
+
+        // The registered interest, Event::None for descriptors not in the loop.
+        Event interest(SocketFD fd) const noexcept;
+
+        size_t runOnce(int timeoutMs);
+        void run();
+
+        // Thread-safe: may be called from any thread, wakes a blocked wait.
+        void stop() noexcept;
+        void post(std::function<void()> job);
+
+        // Loop thread only: runs job at the end of the current iteration, after posted
+        // jobs, without the wake descriptor round trip post() pays. Deferred from
+        // outside an iteration, the next wait returns at once to run it.
+        void defer(std::function<void()> job);
+
+        // One-shot timers, loop thread only, with millisecond resolution; a timer never
+        // fires early. They live in a timing wheel, so arming, cancelling and rearming
+        // are O(1) however many sockets carry a deadline, and the wait is shortened to
+        // the next expiry without any extra syscall. Expired timers run after socket
+        // callbacks, before posted jobs.
+        TimerId runAfter(std::chrono::milliseconds delay, std::function<void()> job);
+        bool cancelTimer(TimerId id) noexcept;
+
+        // Pushes a pending timer's deadline to delay from now and keeps its job: the
+        // cheap way to implement idle and read timeouts, rearmed on every read. False
+        // once the timer has fired or been cancelled.
+        bool rearmTimer(TimerId id, std::chrono::milliseconds delay) noexcept;
+        size_t timers() const noexcept;
+
+        Backend backend() const noexcept;
+        size_t size() const noexcept;
+
+    private:
+        struct Entry
+        {
+            Callback callback;
+            Event interest;
+            uint32_t generation;
+            size_t pollIndex;
+        };
+
+        struct Ready
+        {
+            SocketFD fd;
+            uint32_t generation;
+            Event events;
+        };
+
+        struct Poller;
+
+        int timerTimeout(int timeoutMs);
+        void runTimers();
+        void wait(int timeoutMs);
+        void wake() noexcept;
+        void runPosted();
+        void runDeferred();
+
+        Backend type;
+        std::unique_ptr<Poller> poller;
+        uint32_t nextGeneration;
+        bool dispatching;
+
+        std::vector<std::unique_ptr<Entry>> entries;
+        std::vector<std::unique_ptr<Entry>> retired;
+        std::vector<Ready> ready;
+        size_t count;
+
+        std::atomic<bool> stopRequested;
+        std::atomic<bool> wakePending;
+        std::mutex postedMutex;
+        std::vector<std::function<void()>> posted;
+        std::vector<std::function<void()>> running;
+        std::vector<std::function<void()>> deferred;
+        std::vector<std::function<void()>> runningDeferred;
+
+        std::unique_ptr<TimerWheel> wheel;
+        std::vector<std::function<void()>> expired;
+    };
+}
\ No newline at end of file
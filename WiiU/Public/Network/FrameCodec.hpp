@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+#include "Network/BufferView.hpp"
+#include "Network/Result.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    // Message framing over a byte stream. Received bytes land in one buffer and frames
+    // are parsed in place: next() hands out views into that buffer instead of copies.
+    // Encoding writes header, payload and trailer with a single vectored send.
+    class FrameCodec
+    {
+    public:
+        enum class Framing : uint8_t
+        {
+            LengthPrefix,   // [length][payload]
+            Delimiter       // [payload][delimiter]
+        };
+
+        enum class ByteOrder : uint8_t
+        {
+            Big,
+            Little
+        };
+
+        struct Config
+        {
+            Framing framing = Framing::LengthPrefix;
+            uint8_t prefixBytes = 4;                // 1..8
+            ByteOrder order = ByteOrder::Big;
+            size_t maxFrame = 1 << 20;              // payload limit; larger frames are an Error
+            std::string delimiter = "\n";
+            size_t bufferSize = 64 * 1024;          // initial receive buffer, grows up to one frame
+        };
+
+        static constexpr size_t MaxPayloadParts = 62;
+
+        FrameCodec();
+        explicit FrameCodec(Config config);
+
+        // One recv into the free tail of the buffer.
+        Result receive(TcpSocket& socket) noexcept;
+
+        // For bytes that arrive some other way (e.g. a coroutine recv): write into
+        // writable(), then commit() the count. writable() is empty on allocation failure.
+        MutableBufferView writable() noexcept;
+        void commit(size_t size) noexcept;
+
+        // Data: frame holds the next payload (bytes = its size). WouldBlock: incomplete,
+        // receive more. Error: the frame exceeds maxFrame. The view stays valid until the
+        // next receive() or writable().
+        Result next(ConstBufferView& frame) noexcept;
+
+        size_t buffered() const noexcept;
+        void reset() noexcept;
+
+        // Sends one frame around the payload parts. written counts wire bytes already
+        // out; on WouldBlock call again with the same payload to continue. Data once the
+        // whole frame is sent.
+        Result send(TcpSocket& socket, std::span<ConstBufferView const> payload, size_t& written) const noexcept;
+        Result send(TcpSocket& socket, void const * data, size_t size, size_t& written) const noexcept;
+
+        // Header bytes for a payload of size bytes (length-prefix framing only).
+        size_t header(size_t size, std::byte* out) const noexcept;
+        size_t wireSize(size_t size) const noexcept;
+
+    private:
+        bool reserve() noexcept;
+
+        Config config;
+        std::vector<std::byte> buffer;
+        size_t begin;
+        size_t end;
+        size_t scanned;     // delimiter search resumes here, relative to begin
+        size_t needed;      // wire size of the frame being assembled, 0 when unknown
+    };
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Network/Endpoint.hpp"
+#include "Network/Result.hpp"
+#include "Network/UdpSocket.hpp"
+
+namespace Library::Network
+{
+    // Message transport to one peer over a UdpSocket, with independent channels so a
+    // lost packet only holds back messages of its own ordered channel.
+    //
+    // Every packet carries a sequence number and acknowledges the newest packet seen
+    // plus the 64 before it as a bitfield, so acks repeat across packets and one lost
+    // ack costs nothing. A packet counts as lost once three newer ones are acked, or
+    // one newer one and 9/8 RTT have passed, or after the retransmission timeout
+    // (RFC 6298 estimate from per-packet RTT samples); the last packet of a burst and
+    // a probe after two quiet RTTs ask for an immediate ack so a lost tail is found
+    // quickly. Lost reliable messages are resent in new packets. Messages larger
+    // than a packet are split into fragments and reassembled, and small ones share a
+    // packet. Sending is limited by a congestion window (slow start, halved once per
+    // loss event) and paced at 1.25 x window / RTT. Both ends must use the same channel
+    // layout; there is no handshake or encryption.
+    //
+    // The session is driven from outside: send() queues, update() transmits, and
+    // input() takes datagrams from the peer. pump() does both for a socket used by
+    // this session alone; with one socket for many peers, read it and route each
+    // datagram to its session's input(). Call update() again within timeout().
+    class ReliableUdpSession
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Delivery : uint8_t
+        {
+            ReliableOrdered,    // resent until acked, delivered in send order
+            ReliableUnordered,  // resent until acked, delivered as they complete
+            Unreliable          // sent once; lost fragments drop the message
+        };
+
+        struct Config
+        {
+            std::vector<Delivery> channels = {Delivery::ReliableOrdered};  // up to 256
+            size_t mtu = 1200;                          // UDP payload per packet
+            size_t maxMessage = 1 << 20;
+            size_t maxQueued = 4 * 1024 * 1024;         // unacked bytes before send() returns WouldBlock
+            size_t initialWindow = 10;                  // packets
+            std::chrono::milliseconds ackDelay{5};      // longest a received packet waits for its ack
+            std::chrono::milliseconds initialRto{200};
+            std::chrono::milliseconds minRto{20};
+            std::chrono::milliseconds maxRto{2000};
+
+            // Fraction of outgoing packets silently dropped, to exercise recovery over
+            // loopback. Testing only.
+            double simulatedLoss = 0.0;
+            uint32_t seed = 1;
+        };
+
+        struct Message
+        {
+            uint8_t channel;
+            std::vector<std::byte> data;
+        };
+
+        struct Stats
+        {
+            std::chrono::microseconds srtt{0};          // 0 until the first sample
+            std::chrono::microseconds rttvar{0};
+            std::chrono::microseconds rto{0};
+            size_t window = 0;                          // congestion window in bytes
+            size_t inFlight = 0;                        // bytes sent and not yet acked or lost
+            uint64_t packetsSent = 0;
+            uint64_t packetsReceived = 0;
+            uint64_t packetsLost = 0;                   // declared lost, including spurious
+            uint64_t retransmits = 0;                   // fragments sent again
+            uint64_t probes = 0;                        // ack requests after silence
+            uint64_t simulatedDrops = 0;
+            uint64_t messagesDelivered = 0;
+        };
+
+        ReliableUdpSession(UdpSocket& socket, Endpoint peer);
+        ReliableUdpSession(UdpSocket& socket, Endpoint peer, Config config);
+        ~ReliableUdpSession() noexcept;
+
+        ReliableUdpSession(const ReliableUdpSession&) = delete;
+        ReliableUdpSession& operator=(const ReliableUdpSession&) = delete;
+
+        ReliableUdpSession(ReliableUdpSession&& other) noexcept;
+        ReliableUdpSession& operator=(ReliableUdpSession&& other) noexcept;
+
+        // Queues a message; it goes out on the next update(). WouldBlock: maxQueued
+        // bytes are waiting for acks. Error: unknown channel or larger than maxMessage.
+        Result send(uint8_t channel, void const * data, size_t size);
+
+        // Next delivered message, if any.
+        bool receive(Message& message);
+
+        // One datagram from the peer. Malformed packets are ignored.
+        void input(void const * data, size_t size, Clock::time_point now);
+
+        // Declares losses, transmits what window and pacing allow, sends due acks.
+        void update(Clock::time_point now);
+
+        // Reads every datagram waiting on the socket, keeps the peer's, then updates;
+        // returns the datagrams read.
+        size_t pump(Clock::time_point now);
+
+        // Milliseconds until update() has work (an ack, a paced send, a timeout);
+        // -1 when idle.
+        int timeout(Clock::time_point now) const noexcept;
+
+        // Bytes queued or in flight that the peer has not acked yet.
+        size_t pending() const noexcept;
+
+        Stats stats() const noexcept;
+        Endpoint const & peer() const noexcept;
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> state;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Network/Endpoint.hpp"
+#include "Network/EventLoop.hpp"
+
+namespace Library::Network
+{
+    // Name resolution off the I/O thread. Lookups run on a small worker pool, results
+    // are cached with a TTL (and failures with a shorter negative TTL), and concurrent
+    // requests for the same name share one lookup. Numeric addresses never reach the
+    // workers.
+    class Resolver
+    {
+    public:
+        // Blocking name -> addresses; ports in the result are ignored. An empty result
+        // means the name does not resolve.
+        using Lookup = std::function<std::vector<Endpoint>(std::string const & host)>;
+
+        // Receives every address for the name with the requested port; empty on failure.
+        using Callback = std::function<void(std::vector<Endpoint> const & endpoints)>;
+
+        struct Config
+        {
+            size_t workers = 2;
+            std::chrono::milliseconds ttl{60000};
+            std::chrono::milliseconds negativeTtl{5000};
+            size_t maxEntries = 4096;
+            Lookup lookup; // empty: getaddrinfo
+        };
+
+        Resolver();
+        explicit Resolver(Config config);
+        ~Resolver() noexcept;
+
+        Resolver(const Resolver&) = delete;
+        Resolver& operator=(const Resolver&) = delete;
+
+        // Never blocks: numeric address or fresh positive cache entry, first address only.
+        bool tryResolve(std::string_view host, uint16_t port, Endpoint& endpoint);
+
+        // Callback runs on loop when given (via post), otherwise on a worker thread.
+        // Without a loop, cache hits and numeric addresses complete before resolve
+        // returns; with one they are posted too, so the callback never runs inside
+        // resolve. Destroying the Resolver drops the callbacks of lookups still
+        // queued; a lookup already running completes (and calls back) first.
+        void resolve(std::string host, uint16_t port, Callback callback, EventLoop* loop = nullptr);
+
+        // Blocking convenience for setup code; shares the cache with resolve().
+        std::vector<Endpoint> resolveNow(std::string const & host, uint16_t port);
+
+        void clear();
+
+        static Lookup systemLookup();
+        // Parses a hosts(5) style file once; useful as a deterministic stub.
+        static Lookup hostsFileLookup(std::string const & path);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry
+        {
+            std::vector<Endpoint> addresses;
+            Clock::time_point expires;
+        };
+
+        struct Waiter
+        {
+            uint16_t port;
+            Callback callback;
+            EventLoop* loop;
+        };
+
+        struct Hash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view text) const noexcept { return std::hash<std::string_view>{}(text); }
+        };
+
+        void work();
+        void store(std::string const & host, std::vector<Endpoint> const & addresses);
+        static std::vector<Endpoint> withPort(std::vector<Endpoint> const & addresses, uint16_t port);
+        static void complete(Waiter& waiter, std::vector<Endpoint> endpoints);
+
+        Config config;
+
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        std::unordered_map<std::string, Entry, Hash, std::equal_to<>> cache;
+        std::unordered_map<std::string, std::vector<Waiter>, Hash, std::equal_to<>> inflight;
+        std::deque<std::string> queue;
+        bool stopping;
+        std::vector<std::thread> workers;
+    };
+}
\ No newline at end of file
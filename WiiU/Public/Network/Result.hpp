@@ -9,7 +9,8 @@ namespace Library::Network
         Data,
         WouldBlock,
         Disconnected,
-        Error
+        Error,
+        SourceWouldBlock    // TcpSocket::sendFile: the pipe being sent from has no data yet
     };
 
     struct Result
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include "Network/Define.hpp"
+
+namespace Library::Network
+{
+    // Per-socket tuning. Unset fields are left alone, so the kernel default (or an
+    // earlier setting) stays in place. Options the platform or socket lacks fail the
+    // whole apply with ENOPROTOOPT rather than being skipped; the TCP fields are for
+    // TCP sockets only.
+    struct SocketOptions
+    {
+        struct Keepalive
+        {
+            bool enabled = true;
+            int idleSeconds = 0;        // TCP_KEEPIDLE; 0: system default
+            int intervalSeconds = 0;    // TCP_KEEPINTVL; 0: system default
+            int probes = 0;             // TCP_KEEPCNT; 0: system default
+        };
+
+        // Kernel buffer sizes in bytes. Fixing them turns off Linux autotuning, and
+        // the receive window scale is chosen at connect/listen, so set them before.
+        // Linux reports back twice the requested size (bookkeeping overhead included).
+        std::optional<int> receiveBuffer;           // SO_RCVBUF
+        std::optional<int> sendBuffer;              // SO_SNDBUF
+
+        // TcpSocket enables TCP_NODELAY on connected sockets unless this is false.
+        std::optional<bool> noDelay;                // TCP_NODELAY
+
+        // Acks every segment at once instead of delaying; the kernel may drop back to
+        // delayed acks later, so latency-critical readers re-apply it. Linux only.
+        std::optional<bool> quickAck;               // TCP_QUICKACK
+
+        // Writability is reported only while less than this many bytes are unsent,
+        // which keeps the send queue (and its latency) short. Linux only.
+        std::optional<int> notSentLowWatermark;     // TCP_NOTSENT_LOWAT
+
+        // Microseconds a blocking read may spin on the device queue before sleeping.
+        // Linux only; values above the sysctl limit need CAP_NET_ADMIN.
+        std::optional<int> busyPollUs;              // SO_BUSY_POLL
+
+        std::optional<Keepalive> keepalive;         // SO_KEEPALIVE and timings
+
+        // close() waits up to this many seconds to flush; 0 resets the connection
+        // instead (no TIME_WAIT), negative restores the default background close.
+        std::optional<int> lingerSeconds;           // SO_LINGER
+
+        std::optional<int> priority;                // SO_PRIORITY, 0..6; Linux only
+        std::optional<int> incomingCpu;             // SO_INCOMING_CPU; Linux only
+
+        // Sets every field that has a value, in declaration order, or none of them: each
+        // is read first, so unsupported ones fail before anything changes, and when
+        // setting one fails (e.g. EPERM, EINVAL) those already set get their earlier
+        // values back. The last error is then that of the failure. Fixed buffer sizes
+        // restored that way stay fixed, without Linux autotuning.
+        bool apply(SocketFD fd) const noexcept;
+
+        // The fields this socket reports; the rest stay unset.
+        static SocketOptions query(SocketFD fd) noexcept;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Library::Network
+{
+    enum class Metric : uint8_t
+    {
+        TcpSend,        // send, sendv, sendFile
+        TcpRecv,        // recv, recvv
+        TcpAccept,
+        TcpConnect,
+        UdpSend,        // sendTo, sendBatch
+        UdpRecv         // recvFrom, recvBatch
+    };
+
+    constexpr size_t MetricCount = 6;
+
+    // Syscall latency in power-of-two buckets: bucket i counts calls that took
+    // [2^i, 2^(i+1)) nanoseconds, the last one everything slower.
+    struct LatencyHistogram
+    {
+        static constexpr size_t Buckets = 32;
+
+        std::array<uint64_t, Buckets> counts{};
+
+        uint64_t total() const noexcept;
+
+        // Upper bound in nanoseconds of the bucket holding quantile q (0..1).
+        uint64_t percentile(double q) const noexcept;
+    };
+
+    struct Counters
+    {
+        uint64_t calls = 0;
+        uint64_t bytes = 0;
+        uint64_t wouldBlock = 0;
+        uint64_t disconnects = 0;
+        uint64_t errors = 0;
+        LatencyHistogram latency;
+    };
+
+    struct StatisticsSnapshot
+    {
+        // Error codes too large to get their own entry, e.g. every Winsock WSA code.
+        static constexpr int OtherErrors = -1;
+
+        std::array<Counters, MetricCount> metrics;
+        std::vector<std::pair<int, uint64_t>> errors;   // errno -> failures, ascending errno (OtherErrors first)
+
+        Counters const & operator[](Metric metric) const noexcept
+        {
+            return metrics[static_cast<size_t>(metric)];
+        }
+    };
+
+    // Process-wide socket counters. Each thread updates its own cells without atomic
+    // read-modify-writes or locks; snapshot() sums them, including threads that have
+    // exited. Disabled by default, where every socket call pays one relaxed load.
+    class Statistics
+    {
+    public:
+        static void enable(bool on) noexcept;
+        static bool enabled() noexcept;
+
+        static StatisticsSnapshot snapshot();
+        static void reset() noexcept;
+    };
+
+    // Kernel view of a TCP connection (TCP_INFO), see TcpSocket::tcpInfo.
+    struct TcpInfo
+    {
+        uint32_t rttUs = 0;
+        uint32_t rttVarianceUs = 0;
+        uint32_t retransmits = 0;           // consecutive retransmits of the current segment
+        uint32_t totalRetransmits = 0;
+        uint32_t lost = 0;
+        uint32_t unacked = 0;
+        uint32_t congestionWindow = 0;      // segments
+        uint32_t slowStartThreshold = 0;
+        uint32_t mss = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include "Network/EventLoop.hpp"
+
+namespace Library::Network
+{
+    template<typename T = void>
+    class Task;
+
+    namespace Detail
+    {
+        class PromiseBase
+        {
+        public:
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    PromiseBase& promise = handle.promise();
+                    if(promise.detached)
+                    {
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+                    if(promise.continuation) return promise.continuation;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+
+            void unhandled_exception() noexcept
+            {
+                // Nobody is left to observe the exception, same as an escaping std::thread.
+                if(detached) std::terminate();
+                error = std::current_exception();
+            }
+
+            std::coroutine_handle<> continuation;
+            std::exception_ptr error;
+            bool detached = false;
+        };
+
+        template<typename T>
+        class Promise : public PromiseBase
+        {
+        public:
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& result)
+            {
+                value.emplace(std::forward<U>(result));
+            }
+
+            T take()
+            {
+                if(error) std::rethrow_exception(error);
+                return std::move(*value);
+            }
+
+        private:
+            std::optional<T> value;
+        };
+
+        template<>
+        class Promise<void> : public PromiseBase
+        {
+        public:
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {}
+
+            void take() const
+            {
+                if(error) std::rethrow_exception(error);
+            }
+        };
+    }
+
+    // Lazily started coroutine: the body runs once the task is awaited or spawned.
+    // Awaiting a task transfers straight into it and back to the awaiter when it
+    // finishes, and exceptions thrown inside propagate out of co_await.
+    template<typename T>
+    class Task
+    {
+    public:
+        using promise_type = Detail::Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() noexcept : handle(nullptr) {}
+
+        ~Task() noexcept
+        {
+            if(handle) handle.destroy();
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        auto operator co_await() const noexcept
+        {
+            struct Awaiter
+            {
+                Handle handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return handle.promise().take(); }
+            };
+            return Awaiter{handle};
+        }
+
+        bool done() const noexcept
+        {
+            return !handle || handle.done();
+        }
+
+        Handle release() noexcept
+        {
+            return std::exchange(handle, nullptr);
+        }
+
+    private:
+        friend promise_type;
+
+        explicit Task(Handle handle) noexcept : handle(handle) {}
+
+        Handle handle;
+    };
+
+    namespace Detail
+    {
+        template<typename T>
+        Task<T> Promise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> Promise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+        }
+    }
+
+    // Starts task on loop's thread and lets it run on its own: the frame frees itself
+    // when the body finishes. Safe to call from any thread. A task still suspended
+    // when its loop goes away is never resumed and its frame is not reclaimed.
+    inline void spawn(EventLoop& loop, Task<void> task)
+    {
+        Task<void>::Handle handle = task.release();
+        if(!handle) return;
+
+        handle.promise().detached = true;
+        loop.post([handle]
+        {
+            handle.resume();
+        });
+    }
+}
\ No newline at end of file
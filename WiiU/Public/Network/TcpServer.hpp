@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "Network/EventLoop.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    // Accepts on N worker threads, each running its own EventLoop. Where the kernel
+    // supports SO_REUSEPORT every worker owns a listener and the kernel balances new
+    // connections between them; otherwise the workers share a single listener.
+    class TcpServer
+    {
+    public:
+        struct Config
+        {
+            Endpoint address = Endpoint::any(AddressFamily::IPv4, 0); // interface and port to listen on; port 0: ephemeral
+            bool dualStack = false; // with an IPv6 wildcard address, accept IPv4 clients too
+            size_t workers = 0; // 0: one per hardware thread
+            int backlog = 1024;
+            size_t acceptBatch = 64; // accepts per readiness event before yielding
+            std::chrono::milliseconds acceptBackoff{100}; // pause after a failed accept, e.g. EMFILE
+            SocketOptions listenerOptions; // buffer sizes and keepalive are inherited by accepted sockets
+            SocketOptions connectionOptions; // applied to every accepted socket before the handler runs
+        };
+
+        // Runs on the worker that accepted the connection, with that worker's loop.
+        // An exception escaping it is caught and dropped along with the connection,
+        // so one bad connection never takes the worker down.
+        using AcceptHandler = std::function<void(TcpSocket, EventLoop&)>;
+
+        // Runs on the worker when accept fails with anything but a connection lost
+        // before it was accepted, e.g. EMFILE or ENFILE; gets the platform error code.
+        // That worker then stops watching its listener for acceptBackoff, instead of
+        // waking on the still readable listener in a loop.
+        using ErrorHandler = std::function<void(int error)>;
+
+        TcpServer(Config config, AcceptHandler handler, ErrorHandler onError = {});
+        ~TcpServer() noexcept;
+
+        TcpServer(const TcpServer&) = delete;
+        TcpServer& operator=(const TcpServer&) = delete;
+
+        void start();
+        void stop() noexcept;
+
+        bool running() const noexcept;
+        uint16_t port() const noexcept;
+        size_t workers() const noexcept;
+        EventLoop& loop(size_t worker) noexcept;
+
+    private:
+        struct Worker
+        {
+            EventLoop loop;
+            std::optional<TcpSocket> listener;
+            std::thread thread;
+        };
+
+        void serve(Worker& worker, TcpSocket& listener);
+        void backOff(Worker& worker, TcpSocket& listener, int error);
+
+        Config config;
+        AcceptHandler handler;
+        ErrorHandler onError;
+        std::optional<TcpSocket> shared;
+        std::vector<std::unique_ptr<Worker>> pool;
+        uint16_t boundPort;
+        bool started;
+    };
+}
\ No newline at end of file
@@ -3,9 +3,15 @@
 #include <cstdint>
 #include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
+#include "Network/BufferPool.hpp"
+#include "Network/BufferView.hpp"
 #include "Network/Define.hpp"
+#include "Network/Endpoint.hpp"
 #include "Network/Result.hpp"
+#include "Network/SocketOptions.hpp"
+#include "Network/Statistics.hpp"
 
 namespace Library::Network
 {
@@ -13,6 +19,10 @@ namespace Library::Network
     {
     public:
         TcpSocket();
+        // IPv6 sockets are IPv6 only unless dualStack, which lets one listener on
+        // Endpoint::any(AddressFamily::IPv6, port) accept IPv4 clients too. options are
+        // applied before the constructor returns, i.e. ahead of listen or connect.
+        explicit TcpSocket(AddressFamily family, bool dualStack = false, SocketOptions const & options = {});
         ~TcpSocket() noexcept;
 
         TcpSocket(const TcpSocket&) = delete;
@@ -21,21 +31,83 @@ namespace Library::Network
         TcpSocket(TcpSocket&& other) noexcept;
         TcpSocket& operator=(TcpSocket&& other) noexcept;
 
+        // The port forms listen on every interface of the socket's family. The Endpoint
+        // form binds one address, e.g. to keep a listener on the NIC (and NUMA node) it
+        // serves; a socket of the other family is reopened in the endpoint's first.
         bool listen(uint16_t port);
+        bool listen(uint16_t port, int backlog, bool reusePort = false);
+        bool listen(Endpoint const & local, int backlog = 64, bool reusePort = false);
 
+        // Accepted sockets inherit the listener's buffer sizes and keepalive; the
+        // options overload sets the rest (TCP_NOTSENT_LOWAT, TCP_QUICKACK, ...) before
+        // the socket is handed out, and drops the connection if they fail.
         std::optional<TcpSocket> accept() noexcept;
+        std::optional<TcpSocket> accept(SocketOptions const & options) noexcept;
+
+        // Says why nothing was accepted, classified from the accept call itself: Data
+        // with accepted set; WouldBlock when no connection is pending; Disconnected when
+        // one was dropped (aborted by the peer, or its options failed) and the next may
+        // be accepted at once; Error when the listener failed.
+        Result accept(std::optional<TcpSocket>& accepted, SocketOptions const & options = {}) noexcept;
+
+        // Takes ownership of a connected descriptor, e.g. one accepted by a CompletionEngine.
+        static TcpSocket adopt(SocketFD fd) noexcept;
+
         bool connect(std::string host, uint16_t port) noexcept;
+        bool connect(std::string host, uint16_t port, int timeoutMs) noexcept;
+        bool connect(Endpoint const & endpoint, int timeoutMs = -1) noexcept;
+
+        // Starts a non-blocking connect. Data: connected at once; WouldBlock: pending,
+        // wait for writability (waitWrite or an EventLoop) and call finishConnect().
+        // Like listen, a socket of the other family is reopened in the endpoint's; that
+        // keeps noDelay but drops other options, so construct with the right family.
+        Result connectAsync(Endpoint const & endpoint) noexcept;
+        Result finishConnect() noexcept;
 
         Result send(const void*, size_t) noexcept;
         Result recv(void*, size_t) noexcept;
 
+        // Pooled buffers: recv appends into the free tail, send transmits [data, size).
+        Result send(Buffer const & buffer) noexcept;
+        Result recv(Buffer& buffer) noexcept;
+
+        // Scatter/gather: one syscall for all buffers, may complete partially. Nothing
+        // to transfer (no buffers, or only empty ones) is Data with 0 bytes.
+        Result sendv(std::span<ConstBufferView const> buffers) noexcept;
+        Result recvv(std::span<MutableBufferView const> buffers) noexcept;
+
+        // Sends up to length bytes of a file (or pipe) starting at offset and advances
+        // offset by the bytes sent, so a WouldBlock or short transfer resumes with the
+        // next call. Data with zero bytes means the source is exhausted. WouldBlock
+        // means the socket is full; an empty pipe gives SourceWouldBlock instead, and
+        // the caller waits for the pipe to become readable before retrying.
+        Result sendFile(int fileFd, uint64_t& offset, size_t length) noexcept;
+        Result sendFile(std::string const & path, uint64_t& offset, size_t length) noexcept;
+
         bool waitRead(int timeoutMs) noexcept;
         bool waitWrite(int timeoutMs) noexcept;
 
         void shutdown() noexcept;
 
+        // Samples the kernel's TCP_INFO (RTT, retransmits, congestion window); Linux only.
+        bool tcpInfo(TcpInfo& info) const noexcept;
+
+        bool setOptions(SocketOptions const & options) noexcept;
+        SocketOptions options() const noexcept;
+
+        bool setNonBlocking(bool enable) noexcept;
+        uint16_t localPort() const noexcept;
+        Endpoint localEndpoint() const noexcept;
+        AddressFamily family() const noexcept;
+        SocketFD native() const noexcept;
+
     private:
-        TcpSocket(SocketFD fd) noexcept;
+        TcpSocket(SocketFD fd, AddressFamily family) noexcept;
+        bool reopen(AddressFamily family) noexcept;
+        bool applyNoDelay() noexcept;
+
         SocketFD fd;
+        AddressFamily addressFamily;
+        bool noDelay;   // TCP_NODELAY once connected
     };
 }
\ No newline at end of file
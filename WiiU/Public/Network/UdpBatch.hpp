@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Network/Define.hpp"
+#include "Network/Endpoint.hpp"
+#include "Network/Result.hpp"
+
+namespace Library::Network
+{
+    // Preallocated datagram array for UdpSocket::sendBatch/recvBatch. All kernel
+    // message headers are allocated once in the constructor, so reusing a batch
+    // keeps the per-packet path free of heap allocations.
+    class UdpBatch
+    {
+    public:
+        struct Datagram
+        {
+            void * data;
+            size_t size;
+            size_t capacity;
+            Endpoint peer;
+            Endpoint destination;   // received: the address it was sent to, see UdpSocket::recvFrom
+        };
+
+        explicit UdpBatch(size_t capacity);
+        ~UdpBatch() noexcept;
+
+        UdpBatch(const UdpBatch&) = delete;
+        UdpBatch& operator=(const UdpBatch&) = delete;
+
+        UdpBatch(UdpBatch&& other) noexcept;
+        UdpBatch& operator=(UdpBatch&& other) noexcept;
+
+        // Send side: append an outgoing datagram, false when the batch is full.
+        bool push(Endpoint const & peer, void const * data, size_t size) noexcept;
+
+        // Receive side: attach a buffer to a slot once, then reuse it for every recvBatch.
+        void setBuffer(size_t index, void * data, size_t capacity) noexcept;
+
+        void clear() noexcept;
+        size_t size() const noexcept;
+        size_t capacity() const noexcept;
+
+        Datagram& operator[](size_t index) noexcept;
+        Datagram const & operator[](size_t index) const noexcept;
+
+        Datagram* begin() noexcept;
+        Datagram* end() noexcept;
+        Datagram const * begin() const noexcept;
+        Datagram const * end() const noexcept;
+
+    private:
+        friend class UdpSocket;
+
+        struct Native;
+
+        Result transmit(SocketFD fd, AddressFamily family, size_t first) noexcept;
+        Result receive(SocketFD fd) noexcept;
+
+        std::vector<Datagram> datagrams;
+        std::unique_ptr<Native> native;
+        size_t count;
+    };
+}
\ No newline at end of file
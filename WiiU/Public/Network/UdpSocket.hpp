@@ -3,8 +3,12 @@
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include "Network/BufferPool.hpp"
 #include "Network/Define.hpp"
+#include "Network/Endpoint.hpp"
 #include "Network/Result.hpp"
+#include "Network/SocketOptions.hpp"
+#include "Network/UdpBatch.hpp"
 
 namespace Library::Network
 {
@@ -12,19 +16,93 @@ namespace Library::Network
     {
     public:
         UdpSocket();
+        // IPv6 sockets are IPv6 only unless dualStack; a dual-stack socket also sends
+        // to and receives from IPv4 endpoints. options must leave the TCP fields unset.
+        explicit UdpSocket(AddressFamily family, bool dualStack = false, SocketOptions const & options = {});
         ~UdpSocket();
 
+        // The port form binds every interface of the socket's family, the Endpoint
+        // form one address; the endpoint must be of the socket's family.
         bool bind(uint16_t port);
+        bool bind(Endpoint const & local);
 
+        Result sendTo(Endpoint const & endpoint, void const * data, size_t size) noexcept;
+        Result recvFrom(Endpoint & endpoint, void * data, size_t size) noexcept;
+
+        // Also reports the address the datagram was sent to (port 0): the group for
+        // multicast traffic, so one socket joined to several groups can tell them
+        // apart, or the local address for unicast. recvBatch fills
+        // Datagram::destination alike. Linux only; elsewhere it stays empty.
+        Result recvFrom(Endpoint & source, Endpoint & destination, void * data, size_t size) noexcept;
+
+        // Pooled buffers: recvFrom fills the buffer from its start, one datagram each.
+        Result sendTo(Endpoint const & endpoint, Buffer const & buffer) noexcept;
+        Result recvFrom(Endpoint & endpoint, Buffer& buffer) noexcept;
+
+        // Convenience forms; these parse and format the address on every call.
         Result sendTo(std::string const & host, uint16_t port, void const * data, size_t size) noexcept;
         Result recvFrom(std::string & host, uint16_t & port, void * data, size_t size) noexcept;
 
+        // Batch calls move many datagrams per syscall; Result::bytes counts datagrams.
+        Result sendBatch(UdpBatch& batch, size_t first = 0) noexcept;
+        Result recvBatch(UdpBatch& batch) noexcept;
+
+        // Sends data as datagrams of segmentSize bytes each, the last one possibly
+        // shorter. Linux hands the kernel one buffer per up to 64 segments (UDP_SEGMENT);
+        // without that, or when the route can't offload, the segments go out through
+        // sendmmsg/sendTo. Result::bytes counts payload bytes and always ends on a
+        // segment boundary; after a partial send, continue from there.
+        Result sendSegments(Endpoint const & endpoint, void const * data, size_t size, size_t segmentSize) noexcept;
+
+        // With receive offload on (UDP_GRO), one read may return several datagrams from
+        // the same peer back to back: all segmentSize bytes except a shorter last one.
+        // Without it, or on platforms lacking it, each read is one datagram and
+        // segmentSize is its size, so the same loop serves both. Give it a 64 KiB
+        // buffer; a coalesced read that doesn't fit is truncated.
+        Result recvSegments(Endpoint & endpoint, void * data, size_t size, size_t& segmentSize) noexcept;
+        bool setReceiveOffload(bool enabled) noexcept;
+
+        // Whether sendSegments currently leaves segmentation to the kernel.
+        bool segmentOffload() const noexcept;
+
+        // Multicast membership. The group's port is ignored; bind the socket to the
+        // group's port (any address) to receive it. interfaceIndex 0 lets the routing
+        // table pick, or for an IPv6 group uses its scope id. A dual-stack socket
+        // joins IPv4 groups too. Membership ends with leaveGroup or close.
+        bool joinGroup(Endpoint const & group, uint32_t interfaceIndex = 0) noexcept;
+        bool leaveGroup(Endpoint const & group, uint32_t interfaceIndex = 0) noexcept;
+
+        // Source-specific forms (SSM, 232.0.0.0/8 and ff3x::/32): only traffic from
+        // source is delivered. Several sources may be joined to the same group.
+        // Fail with ENOPROTOOPT where the platform lacks them.
+        bool joinGroup(Endpoint const & group, Endpoint const & source, uint32_t interfaceIndex = 0) noexcept;
+        bool leaveGroup(Endpoint const & group, Endpoint const & source, uint32_t interfaceIndex = 0) noexcept;
+
+        // Outgoing multicast: the interface to send on (0: routing table), the hop
+        // limit (TTL, default 1: link-local only) and whether local members of the
+        // group, this socket included, get a copy (default on). Dual-stack sockets
+        // apply each to IPv4 traffic as well.
+        bool setMulticastInterface(uint32_t interfaceIndex) noexcept;
+        bool setMulticastHops(int hops) noexcept;
+        bool setMulticastLoopback(bool enabled) noexcept;
+
         bool waitRead(int timeoutMs) noexcept;
         bool waitWrite(int timeoutMs) noexcept;
 
         void shutdown();
 
+        bool setOptions(SocketOptions const & options) noexcept;
+        SocketOptions options() const noexcept;
+
+        Endpoint localEndpoint() const noexcept;
+        AddressFamily family() const noexcept;
+        SocketFD native() const noexcept;
+
     private:
+        bool membership(Endpoint const & group, Endpoint const * source, uint32_t interfaceIndex, bool join) noexcept;
+
         SocketFD fd;
+        AddressFamily addressFamily;
+        bool offloadSegments;
     };
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "Network/BufferPool.hpp"
+#include "Network/Result.hpp"
+#include "Network/TcpSocket.hpp"
+
+namespace Library::Network
+{
+    // Sends large payloads with MSG_ZEROCOPY: the kernel transmits from the caller's
+    // pages instead of copying them into the socket buffer, and posts a notification
+    // on the socket's error queue once it no longer needs them. Until then the bytes
+    // must not change, so every zero-copy send keeps its buffer pinned and reap()
+    // hands buffers back as notifications arrive, oldest first. Payloads below the
+    // threshold, and all payloads where SO_ZEROCOPY is missing (Linux before 4.14,
+    // other platforms), take the copying send; they are released at once, or queued
+    // behind earlier zero-copy sends still pending so releases stay in send order.
+    // All MSG_ZEROCOPY sends on the socket must go through the sender.
+    class ZeroCopySender
+    {
+    public:
+        struct Config
+        {
+            // Pinning pages and reading the notification cost more than copying
+            // small payloads; around 10 KiB is where zero-copy starts to pay.
+            size_t threshold = 10 * 1024;
+
+            // Sends awaiting their release; when full, send reaps and then returns
+            // WouldBlock (wait with waitCompletions). Each zero-copy send holds socket
+            // option memory, bounded by net.core.optmem_max.
+            size_t maxPending = 256;
+        };
+
+        // Called once the kernel is done with a send's bytes and with those of every
+        // earlier zero-copy send, so a payload sent in parts can be released by the last.
+        using Release = std::function<void()>;
+
+        explicit ZeroCopySender(TcpSocket socket);
+        ZeroCopySender(TcpSocket socket, Config config);
+
+        // Releases whatever is still pending; drain() first if the bytes are reused.
+        ~ZeroCopySender() noexcept;
+
+        ZeroCopySender(const ZeroCopySender&) = delete;
+        ZeroCopySender& operator=(const ZeroCopySender&) = delete;
+
+        ZeroCopySender(ZeroCopySender&& other) noexcept;
+        ZeroCopySender& operator=(ZeroCopySender&& other) noexcept;
+
+        TcpSocket& socket() noexcept;
+
+        // May send partially like TcpSocket::send; release then covers the bytes taken,
+        // and the rest goes out with a later call. Not called when nothing was sent.
+        Result send(void const * data, size_t size, Release release) noexcept;
+
+        // Holds a handle to the buffer's chunk until the kernel is done with it.
+        Result send(Buffer const & buffer) noexcept;
+
+        // Reads the notifications queued so far and releases the completed sends;
+        // returns how many were released. Never blocks.
+        size_t reap() noexcept;
+
+        // True once notifications are waiting (the socket reports POLLERR). A failed
+        // socket reports POLLERR too: its pending error is then taken (SO_ERROR) and
+        // left as the last error, and the result is false.
+        bool waitCompletions(int timeoutMs) noexcept;
+
+        // Reaps until nothing is pending; false on timeout (-1: no limit), or once the
+        // socket has failed or hung up with sends still pending, since poll then no
+        // longer waits for their notifications.
+        bool drain(int timeoutMs) noexcept;
+
+        size_t pending() const noexcept;
+
+        // Whether SO_ZEROCOPY could be enabled; without it every send copies.
+        bool enabled() const noexcept;
+
+        // Zero-copy sends the kernel copied after all, e.g. over loopback or to a
+        // device without scatter-gather. If most are, raise the threshold.
+        uint64_t copiedSends() const noexcept;
+
+    private:
+        struct Pending
+        {
+            Release release;
+            Buffer buffer;
+            uint32_t id = 0;            // notification id of a zero-copy send
+            bool zeroCopy = false;      // false: copied, queued only to keep release order
+            bool done = false;
+        };
+
+        enum class Wake
+        {
+            Completions,
+            Timeout,
+            Failed
+        };
+
+        Wake await(int timeoutMs) noexcept;
+        Result transmit(void const * data, size_t size, Release& release, Buffer const * buffer) noexcept;
+        void complete(uint32_t first, uint32_t last, bool copied) noexcept;
+        size_t releaseDone() noexcept;
+        void releaseAll() noexcept;
+
+        TcpSocket stream;
+        Config config;
+        bool zeroCopy;
+
+        // Ring of unreleased sends in send order; zero-copy ones take ids from nextId.
+        std::vector<Pending> ring;
+        size_t head;
+        size_t count;
+        uint32_t nextId;
+        uint64_t copied;
+    };
+}
\ No newline at end of file
@@ -1,12 +1,14 @@
+#include "Network/Platform.hpp"
+
 namespace Library::Network
 {
     void Initialize()
     {
-
+        Platform::startup();
     }
 
     void Shutdown()
     {
-
+        Platform::cleanup();
     }
 }
\ No newline at end of file
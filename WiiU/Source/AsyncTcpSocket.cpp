@@ -0,0 +1,347 @@
+#include "Network/AsyncTcpSocket.hpp"
+
+#include <chrono>
+
+namespace Library::Network
+{
+    struct AsyncTcpSocket::State
+    {
+        State(EventLoop& loop, TcpSocket socket) noexcept :
+            loop(loop),
+            socket(std::move(socket)),
+            reader(nullptr),
+            writer(nullptr),
+            interest(Event::None),
+            registered(false)
+        {
+        }
+
+        ~State() noexcept
+        {
+            if(reader != nullptr && reader->timer != 0) loop.cancelTimer(reader->timer);
+            if(writer != nullptr && writer->timer != 0) loop.cancelTimer(writer->timer);
+
+            if(!registered) return;
+            try
+            {
+                loop.remove(socket.native());
+            }
+            catch(...)
+            {
+            }
+        }
+
+        Event wanted() const noexcept
+        {
+            Event events = Event::None;
+            if(reader != nullptr) events = events | Event::Read;
+            if(writer != nullptr) events = events | Event::Write;
+            return events;
+        }
+
+        // Registration is kept while idle, so a coroutine that reads in a loop costs no
+        // epoll_ctl per suspension; it is trimmed when an event finds nobody waiting.
+        bool update()
+        {
+            Event events = wanted();
+            if(events == Event::None || events == interest) return true;
+
+            if(!registered)
+            {
+                bool added = loop.add(socket.native(), events, [this](Event ready)
+                {
+                    onEvent(ready);
+                });
+                if(!added) return false;
+                registered = true;
+            }
+            else if(!loop.modify(socket.native(), events))
+            {
+                return false;
+            }
+
+            interest = events;
+            return true;
+        }
+
+        void trim()
+        {
+            Event events = wanted();
+            if(events == interest) return;
+
+            if(events == Event::None)
+            {
+                loop.remove(socket.native());
+                registered = false;
+                interest = Event::None;
+                return;
+            }
+
+            if(loop.modify(socket.native(), events)) interest = events;
+        }
+
+        bool wait(Waiter& waiter, Waiter*& slot, int timeoutMs)
+        {
+            if(slot != nullptr) return false;
+
+            slot = &waiter;
+            if(!update())
+            {
+                slot = nullptr;
+                return false;
+            }
+
+            if(timeoutMs >= 0)
+            {
+                Waiter* target = &waiter;
+                waiter.timer = loop.runAfter(std::chrono::milliseconds(timeoutMs), [this, target]
+                {
+                    target->timer = 0;
+                    if(reader == target) reader = nullptr;
+                    if(writer == target) writer = nullptr;
+                    target->expire();
+                    trim();
+                    target->handle.resume();
+                });
+            }
+            return true;
+        }
+
+        std::coroutine_handle<> finish(Waiter*& slot) noexcept
+        {
+            Waiter* waiter = slot;
+            slot = nullptr;
+            if(waiter->timer != 0)
+            {
+                loop.cancelTimer(waiter->timer);
+                waiter->timer = 0;
+            }
+            return waiter->handle;
+        }
+
+        void onEvent(Event events)
+        {
+            bool failed = has(events, Event::Error) || has(events, Event::Hangup);
+
+            std::coroutine_handle<> resumeReader;
+            std::coroutine_handle<> resumeWriter;
+            if(reader != nullptr && (failed || has(events, Event::Read)) && reader->attempt()) resumeReader = finish(reader);
+            if(writer != nullptr && (failed || has(events, Event::Write)) && writer->attempt()) resumeWriter = finish(writer);
+
+            if(!resumeReader && !resumeWriter) trim();
+
+            // Resuming may destroy this state, so nothing below touches members.
+            if(resumeReader) resumeReader.resume();
+            if(resumeWriter) resumeWriter.resume();
+        }
+
+        EventLoop& loop;
+        TcpSocket socket;
+        Waiter* reader;
+        Waiter* writer;
+        Event interest;
+        bool registered;
+    };
+
+    AsyncTcpSocket::RecvAwaiter::RecvAwaiter(State* state, void* data, size_t size, int timeoutMs) noexcept :
+        state(state),
+        data(data),
+        size(size),
+        timeoutMs(timeoutMs),
+        result{ResultType::Error, 0}
+    {
+    }
+
+    bool AsyncTcpSocket::RecvAwaiter::await_ready() noexcept
+    {
+        return attempt();
+    }
+
+    bool AsyncTcpSocket::RecvAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+        if(state->wait(*this, state->reader, timeoutMs)) return true;
+
+        result = {ResultType::Error, 0};
+        return false;
+    }
+
+    bool AsyncTcpSocket::RecvAwaiter::attempt() noexcept
+    {
+        result = state->socket.recv(data, size);
+        return result.type != ResultType::WouldBlock;
+    }
+
+    void AsyncTcpSocket::RecvAwaiter::expire() noexcept
+    {
+        result = {ResultType::WouldBlock, 0};
+    }
+
+    AsyncTcpSocket::SendAwaiter::SendAwaiter(State* state, void const * data, size_t size, int timeoutMs) noexcept :
+        state(state),
+        data(data),
+        size(size),
+        sent(0),
+        timeoutMs(timeoutMs),
+        result{ResultType::Error, 0}
+    {
+    }
+
+    bool AsyncTcpSocket::SendAwaiter::await_ready() noexcept
+    {
+        return attempt();
+    }
+
+    bool AsyncTcpSocket::SendAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+        if(state->wait(*this, state->writer, timeoutMs)) return true;
+
+        result = {ResultType::Error, sent};
+        return false;
+    }
+
+    bool AsyncTcpSocket::SendAwaiter::attempt() noexcept
+    {
+        std::byte const * bytes = static_cast<std::byte const *>(data);
+        while(sent < size)
+        {
+            Result res = state->socket.send(bytes + sent, size - sent);
+            if(res.type == ResultType::WouldBlock) return false;
+            if(res.type != ResultType::Data)
+            {
+                result = {res.type, sent};
+                return true;
+            }
+            sent += res.bytes;
+        }
+
+        result = {ResultType::Data, sent};
+        return true;
+    }
+
+    void AsyncTcpSocket::SendAwaiter::expire() noexcept
+    {
+        result = {ResultType::WouldBlock, sent};
+    }
+
+    AsyncTcpSocket::ConnectAwaiter::ConnectAwaiter(State* state, Endpoint const & endpoint, int timeoutMs) noexcept :
+        state(state),
+        endpoint(endpoint),
+        timeoutMs(timeoutMs),
+        connected(false)
+    {
+    }
+
+    bool AsyncTcpSocket::ConnectAwaiter::await_ready() noexcept
+    {
+        Result res = state->socket.connectAsync(endpoint);
+        connected = res.type == ResultType::Data;
+        return res.type != ResultType::WouldBlock;
+    }
+
+    bool AsyncTcpSocket::ConnectAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+        return state->wait(*this, state->writer, timeoutMs);
+    }
+
+    bool AsyncTcpSocket::ConnectAwaiter::attempt() noexcept
+    {
+        Result res = state->socket.finishConnect();
+        if(res.type == ResultType::WouldBlock) return false;
+
+        connected = res.type == ResultType::Data;
+        return true;
+    }
+
+    void AsyncTcpSocket::ConnectAwaiter::expire() noexcept
+    {
+        connected = false;
+    }
+
+    AsyncTcpSocket::AcceptAwaiter::AcceptAwaiter(State* state) noexcept : state(state)
+    {
+    }
+
+    bool AsyncTcpSocket::AcceptAwaiter::await_ready() noexcept
+    {
+        return attempt();
+    }
+
+    bool AsyncTcpSocket::AcceptAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+        return state->wait(*this, state->reader, -1);
+    }
+
+    std::optional<AsyncTcpSocket> AsyncTcpSocket::AcceptAwaiter::await_resume()
+    {
+        if(!accepted) return std::nullopt;
+        return AsyncTcpSocket(state->loop, std::move(*accepted));
+    }
+
+    bool AsyncTcpSocket::AcceptAwaiter::attempt() noexcept
+    {
+        while(true)
+        {
+            // A dropped connection leaves the listener usable; the next may be ready.
+            Result res = state->socket.accept(accepted);
+            if(res.type == ResultType::Disconnected) continue;
+            return res.type != ResultType::WouldBlock;
+        }
+    }
+
+    void AsyncTcpSocket::AcceptAwaiter::expire() noexcept
+    {
+    }
+
+    AsyncTcpSocket::AsyncTcpSocket(EventLoop& loop) : AsyncTcpSocket(loop, TcpSocket())
+    {
+    }
+
+    AsyncTcpSocket::AsyncTcpSocket(EventLoop& loop, TcpSocket socket) : state(std::make_unique<State>(loop, std::move(socket)))
+    {
+        state->socket.setNonBlocking(true);
+    }
+
+    AsyncTcpSocket::~AsyncTcpSocket() noexcept = default;
+
+    AsyncTcpSocket::AsyncTcpSocket(AsyncTcpSocket&& other) noexcept = default;
+    AsyncTcpSocket& AsyncTcpSocket::operator=(AsyncTcpSocket&& other) noexcept = default;
+
+    bool AsyncTcpSocket::listen(uint16_t port, int backlog)
+    {
+        return state->socket.listen(port, backlog);
+    }
+
+    AsyncTcpSocket::AcceptAwaiter AsyncTcpSocket::accept() noexcept
+    {
+        return AcceptAwaiter(state.get());
+    }
+
+    AsyncTcpSocket::ConnectAwaiter AsyncTcpSocket::connect(Endpoint const & endpoint, int timeoutMs) noexcept
+    {
+        return ConnectAwaiter(state.get(), endpoint, timeoutMs);
+    }
+
+    AsyncTcpSocket::RecvAwaiter AsyncTcpSocket::recv(void* data, size_t size, int timeoutMs) noexcept
+    {
+        return RecvAwaiter(state.get(), data, size, timeoutMs);
+    }
+
+    AsyncTcpSocket::SendAwaiter AsyncTcpSocket::send(void const * data, size_t size, int timeoutMs) noexcept
+    {
+        return SendAwaiter(state.get(), data, size, timeoutMs);
+    }
+
+    TcpSocket& AsyncTcpSocket::socket() noexcept
+    {
+        return state->socket;
+    }
+
+    EventLoop& AsyncTcpSocket::loop() noexcept
+    {
+        return state->loop;
+    }
+}
\ No newline at end of file
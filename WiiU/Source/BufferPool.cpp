@@ -0,0 +1,331 @@
+#include "Network/BufferPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace Library::Network
+{
+    struct alignas(64) BufferChunk
+    {
+        std::atomic<uint32_t> refs;
+        BufferArena* arena;
+        BufferChunk* next;
+
+        std::byte* payload() noexcept
+        {
+            return reinterpret_cast<std::byte*>(this) + sizeof(BufferChunk);
+        }
+    };
+
+    struct BufferArena : std::enable_shared_from_this<BufferArena>
+    {
+        size_t chunkSize;
+        size_t stride;
+        size_t maxChunks;
+        size_t chunksPerSlab;
+
+        std::mutex mutex;
+        std::vector<std::byte*> slabs;
+        BufferChunk* freeList = nullptr;
+        std::atomic<size_t> allocated{0};
+
+        BufferArena(size_t chunkSize, size_t maxChunks, size_t chunksPerSlab) :
+            chunkSize(chunkSize),
+            stride((sizeof(BufferChunk) + chunkSize + alignof(BufferChunk) - 1) / alignof(BufferChunk) * alignof(BufferChunk)),
+            maxChunks(maxChunks),
+            chunksPerSlab(chunksPerSlab)
+        {
+        }
+
+        ~BufferArena() noexcept
+        {
+            for(std::byte* slab : slabs) ::operator delete(slab, std::align_val_t(alignof(BufferChunk)));
+        }
+
+        // Moves up to count free chunks into out; grows by one slab when the list is dry.
+        void take(std::vector<BufferChunk*>& out, size_t count) noexcept
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if(freeList == nullptr) grow();
+
+            while(count > 0 && freeList != nullptr)
+            {
+                out.push_back(freeList);
+                freeList = freeList->next;
+                --count;
+            }
+        }
+
+        void give(BufferChunk* const * chunks, size_t count) noexcept
+        {
+            if(count == 0) return;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for(size_t i = 0; i < count; ++i)
+            {
+                chunks[i]->next = freeList;
+                freeList = chunks[i];
+            }
+        }
+
+    private:
+        void grow() noexcept
+        {
+            size_t current = allocated.load(std::memory_order_relaxed);
+            size_t count = std::min(chunksPerSlab, maxChunks - current);
+            if(count == 0) return;
+
+            std::byte* slab = static_cast<std::byte*>(::operator new(stride * count, std::align_val_t(alignof(BufferChunk)), std::nothrow));
+            if(slab == nullptr) return;
+
+            try
+            {
+                slabs.push_back(slab);
+            }
+            catch(...)
+            {
+                ::operator delete(slab, std::align_val_t(alignof(BufferChunk)));
+                return;
+            }
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                BufferChunk* chunk = new (slab + i * stride) BufferChunk{{0}, this, freeList};
+                freeList = chunk;
+            }
+            allocated.store(current + count, std::memory_order_relaxed);
+        }
+    };
+
+    namespace
+    {
+        constexpr size_t CacheSlots = 4;
+        constexpr size_t CacheLimit = 64;
+        constexpr size_t CacheRefill = 16;
+
+        // Per-thread free lists in front of each arena's locked list. Slots are keyed by
+        // arena address and validated through the weak reference, so a dead arena's
+        // leftovers are dropped rather than handed out.
+        struct ThreadCache
+        {
+            struct Slot
+            {
+                BufferArena* key = nullptr;
+                std::weak_ptr<BufferArena> owner;
+                std::vector<BufferChunk*> chunks;
+            };
+
+            std::array<Slot, CacheSlots> slots;
+            size_t victim = 0;
+
+            ~ThreadCache() noexcept
+            {
+                for(Slot& slot : slots) flush(slot);
+            }
+
+            static void flush(Slot& slot) noexcept
+            {
+                if(std::shared_ptr<BufferArena> arena = slot.owner.lock())
+                {
+                    arena->give(slot.chunks.data(), slot.chunks.size());
+                }
+                slot.chunks.clear();
+                slot.key = nullptr;
+                slot.owner.reset();
+            }
+
+            Slot& find(BufferArena* arena) noexcept
+            {
+                for(Slot& slot : slots)
+                {
+                    if(slot.key != arena) continue;
+                    if(!slot.owner.expired()) return slot;
+
+                    // Same address, new arena: the cached chunks belong to a dead one.
+                    slot.chunks.clear();
+                    slot.owner = arena->weak_from_this();
+                    return slot;
+                }
+
+                Slot& slot = slots[victim];
+                victim = (victim + 1) % slots.size();
+                flush(slot);
+                slot.key = arena;
+                slot.owner = arena->weak_from_this();
+                slot.chunks.reserve(CacheLimit);
+                return slot;
+            }
+        };
+
+        thread_local ThreadCache cache;
+
+        void release(BufferChunk* chunk) noexcept
+        {
+            BufferArena* arena = chunk->arena;
+            ThreadCache::Slot& slot = cache.find(arena);
+
+            if(slot.chunks.size() == CacheLimit)
+            {
+                size_t half = CacheLimit / 2;
+                arena->give(slot.chunks.data() + half, CacheLimit - half);
+                slot.chunks.resize(half);
+            }
+            slot.chunks.push_back(chunk);
+        }
+    }
+
+    Buffer::Buffer(BufferChunk* chunk, std::byte* bytes, size_t length, size_t room) noexcept :
+        chunk(chunk),
+        bytes(bytes),
+        length(length),
+        room(room)
+    {
+    }
+
+    Buffer::~Buffer() noexcept
+    {
+        reset();
+    }
+
+    Buffer::Buffer(const Buffer& other) noexcept :
+        chunk(other.chunk),
+        bytes(other.bytes),
+        length(other.length),
+        room(other.room)
+    {
+        if(chunk != nullptr) chunk->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Buffer& Buffer::operator=(const Buffer& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(other.chunk != nullptr) other.chunk->refs.fetch_add(1, std::memory_order_relaxed);
+            reset();
+            chunk = other.chunk;
+            bytes = other.bytes;
+            length = other.length;
+            room = other.room;
+        }
+        return *this;
+    }
+
+    Buffer::Buffer(Buffer&& other) noexcept :
+        chunk(other.chunk),
+        bytes(other.bytes),
+        length(other.length),
+        room(other.room)
+    {
+        other.chunk = nullptr;
+        other.bytes = nullptr;
+        other.length = 0;
+        other.room = 0;
+    }
+
+    Buffer& Buffer::operator=(Buffer&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            chunk = other.chunk;
+            bytes = other.bytes;
+            length = other.length;
+            room = other.room;
+            other.chunk = nullptr;
+            other.bytes = nullptr;
+            other.length = 0;
+            other.room = 0;
+        }
+        return *this;
+    }
+
+    Buffer Buffer::slice(size_t offset, size_t count) const noexcept
+    {
+        if(chunk == nullptr) return Buffer();
+
+        offset = std::min(offset, length);
+        count = std::min(count, length - offset);
+
+        chunk->refs.fetch_add(1, std::memory_order_relaxed);
+        // Slices are read views: their capacity ends at their size so a receive into
+        // one can never overwrite bytes another handle still sees.
+        return Buffer(chunk, bytes + offset, count, count);
+    }
+
+    void Buffer::resize(size_t count) noexcept
+    {
+        length = std::min(count, room);
+    }
+
+    void Buffer::consume(size_t count) noexcept
+    {
+        count = std::min(count, length);
+        bytes += count;
+        length -= count;
+        room -= count;
+    }
+
+    uint32_t Buffer::useCount() const noexcept
+    {
+        if(chunk == nullptr) return 0;
+        return chunk->refs.load(std::memory_order_relaxed);
+    }
+
+    void Buffer::reset() noexcept
+    {
+        if(chunk != nullptr && chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            release(chunk);
+        }
+        chunk = nullptr;
+        bytes = nullptr;
+        length = 0;
+        room = 0;
+    }
+
+    BufferPool::BufferPool(size_t chunkSize, size_t maxChunks, size_t chunksPerSlab)
+    {
+        if(chunkSize == 0 || maxChunks == 0 || chunksPerSlab == 0) throw std::invalid_argument("buffer pool sizes must be non-zero");
+
+        arena = std::make_shared<BufferArena>(chunkSize, maxChunks, chunksPerSlab);
+    }
+
+    BufferPool::~BufferPool() noexcept = default;
+
+    Buffer BufferPool::acquire() noexcept
+    {
+        ThreadCache::Slot& slot = cache.find(arena.get());
+        if(slot.chunks.empty())
+        {
+            arena->take(slot.chunks, CacheRefill);
+            if(slot.chunks.empty()) return Buffer();
+        }
+
+        BufferChunk* chunk = slot.chunks.back();
+        slot.chunks.pop_back();
+
+        chunk->refs.store(1, std::memory_order_relaxed);
+        return Buffer(chunk, chunk->payload(), 0, arena->chunkSize);
+    }
+
+    size_t BufferPool::chunkSize() const noexcept
+    {
+        return arena->chunkSize;
+    }
+
+    size_t BufferPool::maxChunks() const noexcept
+    {
+        return arena->maxChunks;
+    }
+
+    size_t BufferPool::allocatedChunks() const noexcept
+    {
+        return arena->allocated.load(std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
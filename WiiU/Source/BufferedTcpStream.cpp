@@ -0,0 +1,385 @@
+#include "Network/BufferedTcpStream.hpp"
+#include "Network/Platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Library::Network
+{
+    BufferedTcpStream::BufferedTcpStream(TcpSocket socket) : BufferedTcpStream(std::move(socket), Config{})
+    {
+    }
+
+    BufferedTcpStream::BufferedTcpStream(TcpSocket socket, Config config) :
+        stream(std::move(socket)),
+        config(config),
+        head(0),
+        queued(0),
+        flushScheduled(false),
+        watch(Watch::None),
+        readPos(0),
+        readEnd(0),
+        self(std::make_shared<BufferedTcpStream*>(this))
+    {
+        if(this->config.readAhead == 0) this->config.readAhead = 1;
+    }
+
+    BufferedTcpStream::~BufferedTcpStream() noexcept
+    {
+        unwatchWritable();
+    }
+
+    BufferedTcpStream::BufferedTcpStream(BufferedTcpStream&& other) noexcept :
+        stream(std::move(other.stream)),
+        config(other.config),
+        ring(std::move(other.ring)),
+        head(other.head),
+        queued(other.queued),
+        flushScheduled(other.flushScheduled),
+        watch(other.watch),
+        input(std::move(other.input)),
+        readPos(other.readPos),
+        readEnd(other.readEnd),
+        self(std::move(other.self))
+    {
+        if(self) *self = this;
+        other.head = other.queued = other.readPos = other.readEnd = 0;
+        other.flushScheduled = false;
+        other.watch = Watch::None;
+    }
+
+    BufferedTcpStream& BufferedTcpStream::operator=(BufferedTcpStream&& other) noexcept
+    {
+        if(this != &other)
+        {
+            unwatchWritable();
+
+            stream = std::move(other.stream);
+            config = other.config;
+            ring = std::move(other.ring);
+            head = other.head;
+            queued = other.queued;
+            flushScheduled = other.flushScheduled;
+            watch = other.watch;
+            input = std::move(other.input);
+            readPos = other.readPos;
+            readEnd = other.readEnd;
+            self = std::move(other.self);
+            if(self) *self = this;
+
+            other.head = other.queued = other.readPos = other.readEnd = 0;
+            other.flushScheduled = false;
+            other.watch = Watch::None;
+        }
+        return *this;
+    }
+
+    TcpSocket& BufferedTcpStream::socket() noexcept
+    {
+        return stream;
+    }
+
+    Result BufferedTcpStream::write(void const * data, size_t size)
+    {
+        if(size == 0) return {ResultType::Data, 0};
+
+        std::byte const * bytes = static_cast<std::byte const *>(data);
+        size_t sent = 0;
+
+        // Nothing to coalesce with: large writes skip the copy.
+        if(queued == 0 && size >= config.flushThreshold)
+        {
+            Result res = stream.send(bytes, size);
+            if(res.type == ResultType::Error || res.type == ResultType::Disconnected) return res;
+            if(res.type == ResultType::Data) sent = res.bytes;
+            if(sent == size) return {ResultType::Data, size};
+        }
+
+        size_t rest = size - sent;
+        if(queued + rest > config.maxQueued)
+        {
+            if(sent > 0) return {ResultType::Data, sent};
+            return {ResultType::WouldBlock, 0};
+        }
+
+        grow(queued + rest);
+        enqueue(bytes + sent, rest);
+
+        if(queued >= config.flushThreshold)
+        {
+            Result res = flush();
+            if(res.type == ResultType::Error || res.type == ResultType::Disconnected) return res;
+        }
+        else
+        {
+            scheduleFlush();
+        }
+
+        return {ResultType::Data, size};
+    }
+
+    Result BufferedTcpStream::flush() noexcept
+    {
+        size_t flushed = 0;
+        while(queued > 0)
+        {
+            size_t capacity = ring.size();
+            size_t first = std::min(queued, capacity - head);
+            ConstBufferView views[2] =
+            {
+                {ring.data() + head, first},
+                {ring.data(), queued - first}
+            };
+
+            Result res = stream.sendv(std::span<ConstBufferView const>(views, queued > first ? 2 : 1));
+            if(res.type == ResultType::WouldBlock)
+            {
+                watchWritable();
+                return {ResultType::WouldBlock, flushed};
+            }
+            if(res.type != ResultType::Data)
+            {
+                unwatchWritable();
+                return {res.type, flushed};
+            }
+
+            head = (head + res.bytes) & (capacity - 1);
+            queued -= res.bytes;
+            flushed += res.bytes;
+        }
+
+        head = 0;
+        unwatchWritable();
+        return {ResultType::Data, flushed};
+    }
+
+    size_t BufferedTcpStream::pending() const noexcept
+    {
+        return queued;
+    }
+
+    bool BufferedTcpStream::cork(bool enable) noexcept
+    {
+#if defined(__linux__)
+        int v = enable ? 1 : 0;
+        return Platform::setOption(stream.native(), IPPROTO_TCP, TCP_CORK, v);
+#else
+        (void)enable;
+        return false;
+#endif
+    }
+
+    Result BufferedTcpStream::read(void * data, size_t size) noexcept
+    {
+        if(size == 0) return {ResultType::Data, 0};
+
+        if(readPos == readEnd)
+        {
+            if(size >= config.readAhead) return stream.recv(data, size);
+
+            Result res = fill();
+            if(res.type != ResultType::Data) return res;
+        }
+
+        size_t count = std::min(size, readEnd - readPos);
+        std::memcpy(data, input.data() + readPos, count);
+        readPos += count;
+        return {ResultType::Data, count};
+    }
+
+    Result BufferedTcpStream::readExact(void * data, size_t size) noexcept
+    {
+        while(readEnd - readPos < size)
+        {
+            if(input.size() - readPos < size)
+            {
+                // Make room for the whole record before reading more of it.
+                if(readPos > 0)
+                {
+                    std::memmove(input.data(), input.data() + readPos, readEnd - readPos);
+                    readEnd -= readPos;
+                    readPos = 0;
+                }
+
+                try
+                {
+                    if(input.size() < size) input.resize(size);
+                }
+                catch(...)
+                {
+                    return {ResultType::Error, 0};
+                }
+            }
+
+            Result res = fill();
+            if(res.type != ResultType::Data) return res;
+        }
+
+        std::memcpy(data, input.data() + readPos, size);
+        readPos += size;
+        return {ResultType::Data, size};
+    }
+
+    Result BufferedTcpStream::readLine(std::string_view& line) noexcept
+    {
+        size_t scanned = 0;
+        while(true)
+        {
+            char const * begin = reinterpret_cast<char const *>(input.data()) + readPos;
+            size_t available = readEnd - readPos;
+
+            void const * found = available > scanned ? std::memchr(begin + scanned, '\n', available - scanned) : nullptr;
+            if(found != nullptr)
+            {
+                size_t length = static_cast<char const *>(found) - begin;
+                readPos += length + 1;
+                if(length > 0 && begin[length - 1] == '\r') --length;
+                line = std::string_view(begin, length);
+                return {ResultType::Data, length};
+            }
+
+            scanned = available;
+            if(available >= config.maxLine) return {ResultType::Error, 0};
+
+            Result res = fill();
+            if(res.type != ResultType::Data) return res;
+        }
+    }
+
+    size_t BufferedTcpStream::buffered() const noexcept
+    {
+        return readEnd - readPos;
+    }
+
+    Result BufferedTcpStream::fill() noexcept
+    {
+        if(readPos == readEnd)
+        {
+            readPos = 0;
+            readEnd = 0;
+        }
+
+        try
+        {
+            if(input.empty()) input.resize(config.readAhead);
+        }
+        catch(...)
+        {
+            return {ResultType::Error, 0};
+        }
+
+        if(readEnd == input.size() && readPos > 0)
+        {
+            std::memmove(input.data(), input.data() + readPos, readEnd - readPos);
+            readEnd -= readPos;
+            readPos = 0;
+        }
+
+        if(readEnd == input.size())
+        {
+            size_t limit = std::max(config.readAhead, config.maxLine);
+            if(input.size() >= limit) return {ResultType::Error, 0};
+
+            try
+            {
+                input.resize(std::min(input.size() * 2, limit));
+            }
+            catch(...)
+            {
+                return {ResultType::Error, 0};
+            }
+        }
+
+        Result res = stream.recv(input.data() + readEnd, input.size() - readEnd);
+        if(res.type == ResultType::Data) readEnd += res.bytes;
+        return res;
+    }
+
+    void BufferedTcpStream::scheduleFlush()
+    {
+        if(config.loop == nullptr || flushScheduled || !self) return;
+
+        flushScheduled = true;
+        config.loop->defer([weak = std::weak_ptr<BufferedTcpStream*>(self)]
+        {
+            std::shared_ptr<BufferedTcpStream*> stream = weak.lock();
+            if(!stream) return;
+
+            (*stream)->flushScheduled = false;
+            (*stream)->flush();
+        });
+    }
+
+    void BufferedTcpStream::watchWritable() noexcept
+    {
+        if(config.loop == nullptr || watch != Watch::None || !self) return;
+
+        SocketFD fd = stream.native();
+        EventLoop& loop = *config.loop;
+        if(loop.contains(fd))
+        {
+            // An owner already waiting for Write calls flush() anyway; leave it be.
+            Event interest = loop.interest(fd);
+            if(!has(interest, Event::Write) && loop.modify(fd, interest | Event::Write)) watch = Watch::Shared;
+            return;
+        }
+
+        try
+        {
+            bool added = loop.add(fd, Event::Write, [weak = std::weak_ptr<BufferedTcpStream*>(self)](Event)
+            {
+                std::shared_ptr<BufferedTcpStream*> stream = weak.lock();
+                if(stream) (*stream)->flush();
+            });
+            if(added) watch = Watch::Owned;
+        }
+        catch(...)
+        {
+            // Without the watch the queue goes out with the next write or flush.
+        }
+    }
+
+    void BufferedTcpStream::unwatchWritable() noexcept
+    {
+        if(watch == Watch::None) return;
+
+        SocketFD fd = stream.native();
+        EventLoop& loop = *config.loop;
+        try
+        {
+            if(watch == Watch::Owned) loop.remove(fd);
+            else loop.modify(fd, loop.interest(fd) & Event::Read);
+        }
+        catch(...)
+        {
+        }
+        watch = Watch::None;
+    }
+
+    void BufferedTcpStream::grow(size_t required)
+    {
+        if(required <= ring.size()) return;
+
+        size_t capacity = ring.empty() ? 4096 : ring.size();
+        while(capacity < required) capacity *= 2;
+
+        std::vector<std::byte> next(capacity);
+        size_t first = std::min(queued, ring.size() - head);
+        if(first > 0) std::memcpy(next.data(), ring.data() + head, first);
+        if(queued > first) std::memcpy(next.data() + first, ring.data(), queued - first);
+
+        ring.swap(next);
+        head = 0;
+    }
+
+    void BufferedTcpStream::enqueue(std::byte const * data, size_t size) noexcept
+    {
+        size_t capacity = ring.size();
+        size_t tail = (head + queued) & (capacity - 1);
+        size_t first = std::min(size, capacity - tail);
+
+        std::memcpy(ring.data() + tail, data, first);
+        if(size > first) std::memcpy(ring.data(), data + first, size - first);
+        queued += size;
+    }
+}
\ No newline at end of file
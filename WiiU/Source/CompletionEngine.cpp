@@ -0,0 +1,797 @@
+#include "Network/CompletionEngine.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define NETWORK_HAS_IO_URING 1
+#endif
+
+#include <cerrno>
+#include <system_error>
+
+#if defined(NETWORK_HAS_IO_URING)
+#include "Network/SocketAddress.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#endif
+
+namespace Library::Network
+{
+#if defined(NETWORK_HAS_IO_URING)
+    namespace
+    {
+        int setup(unsigned entries, io_uring_params* params) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int enter(int fd, unsigned submit, unsigned wait, unsigned flags, void const * arg, size_t argSize) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, wait, flags, arg, argSize));
+        }
+
+        int registerResource(int fd, unsigned opcode, void const * arg, unsigned count) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+        }
+
+        template<typename T>
+        T loadAcquire(T const * p) noexcept
+        {
+            return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+        }
+
+        template<typename T>
+        void storeRelease(T* p, T value) noexcept
+        {
+            __atomic_store_n(p, value, __ATOMIC_RELEASE);
+        }
+
+        // user_data carries the slot index and the slot's generation, so a completion or
+        // cancel aimed at an operation never matches a later one reusing its slot.
+        uint64_t pack(uint32_t index, uint32_t generation) noexcept
+        {
+            return (static_cast<uint64_t>(generation) << 32) | index;
+        }
+
+        // Completion of run()'s own timeout; its index matches no slot.
+        constexpr uint64_t TimeoutToken = ~uint64_t(0);
+
+        bool opcodeSupported(int fd, uint8_t opcode) noexcept
+        {
+            constexpr unsigned MaxOps = 256;
+            alignas(io_uring_probe) std::byte storage[sizeof(io_uring_probe) + MaxOps * sizeof(io_uring_probe_op)]{};
+            if(registerResource(fd, IORING_REGISTER_PROBE, storage, MaxOps) < 0) return false;
+
+            // As with io_uring_buf_ring, the ops array is addressed past the header by hand.
+            io_uring_probe const * probe = reinterpret_cast<io_uring_probe const *>(storage);
+            io_uring_probe_op const * ops = reinterpret_cast<io_uring_probe_op const *>(storage + sizeof(io_uring_probe));
+            return opcode <= probe->last_op && opcode < probe->ops_len && (ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+
+        Result toResult(CompletionEngine::Operation operation, int res) noexcept
+        {
+            using Operation = CompletionEngine::Operation;
+
+            if(res < 0)
+            {
+                int error = -res;
+                if(error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS) return {ResultType::WouldBlock, 0};
+                if(error == ECONNRESET || error == EPIPE || error == ENOTCONN) return {ResultType::Disconnected, 0};
+                return {ResultType::Error, 0};
+            }
+
+            bool receive = operation == Operation::Recv || operation == Operation::RecvFrom || operation == Operation::RecvFixed;
+            if(receive && res == 0) return {ResultType::Disconnected, 0};
+
+            if(operation == Operation::Accept || operation == Operation::Poll || operation == Operation::Cancel) return {ResultType::Data, 0};
+            return {ResultType::Data, static_cast<size_t>(res)};
+        }
+    }
+
+    struct CompletionEngine::Ring
+    {
+        struct Slot
+        {
+            uint64_t userData;
+            Operation operation;
+            bool active;
+            uint32_t generation;
+            uint32_t nextFree;
+            uint16_t group;
+            int sent;                   // zero-copy SendFixed: result held until the notification
+            SocketAddress addr;
+            msghdr msg;
+            iovec iov;
+        };
+
+        struct BufferGroup
+        {
+            io_uring_buf_ring* ring = nullptr;
+            size_t ringBytes = 0;
+            std::byte* memory = nullptr;
+            size_t size = 0;
+            uint16_t count = 0;
+            uint16_t tail = 0;
+        };
+
+        static constexpr uint32_t NoSlot = ~uint32_t(0);
+
+        int fd = -1;
+        unsigned features = 0;
+        bool sendZeroCopy = false;      // IORING_OP_SEND_ZC, Linux 6.0
+
+        void* sqMap = nullptr;
+        size_t sqMapSize = 0;
+        void* cqMap = nullptr;
+        size_t cqMapSize = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqesSize = 0;
+
+        unsigned* sqHead = nullptr;
+        unsigned* sqTail = nullptr;
+        unsigned sqMask = 0;
+        unsigned sqEntries = 0;
+        unsigned* sqArray = nullptr;
+        unsigned localTail = 0;
+        unsigned pending = 0;
+
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned cqMask = 0;
+        io_uring_cqe* cqes = nullptr;
+
+        std::vector<Slot> slots;
+        uint32_t freeSlot = NoSlot;
+        size_t active = 0;
+
+        // run()'s wait limit on kernels without IORING_FEAT_EXT_ARG, read at submission.
+        __kernel_timespec timeout{};
+
+        std::vector<iovec> fixedBuffers;
+        std::vector<BufferGroup> groups;
+
+        ~Ring() noexcept
+        {
+            for(BufferGroup& group : groups)
+            {
+                if(group.ring != nullptr) ::munmap(group.ring, group.ringBytes);
+                delete[] group.memory;
+            }
+            if(sqes != nullptr) ::munmap(sqes, sqesSize);
+            if(cqMap != nullptr && cqMap != sqMap) ::munmap(cqMap, cqMapSize);
+            if(sqMap != nullptr) ::munmap(sqMap, sqMapSize);
+            if(fd >= 0) ::close(fd);
+        }
+
+        uint32_t allocate(uint64_t userData, Operation operation) noexcept
+        {
+            uint32_t index = freeSlot;
+            if(index == NoSlot) return NoSlot;
+
+            Slot& slot = slots[index];
+            freeSlot = slot.nextFree;
+            slot.userData = userData;
+            slot.operation = operation;
+            slot.active = true;
+            ++slot.generation;
+            ++active;
+            return index;
+        }
+
+        void release(uint32_t index) noexcept
+        {
+            Slot& slot = slots[index];
+            slot.active = false;
+            slot.nextFree = freeSlot;
+            freeSlot = index;
+            --active;
+        }
+
+        io_uring_sqe* acquire() noexcept
+        {
+            if(localTail - loadAcquire(sqHead) == sqEntries)
+            {
+                flush();
+                if(localTail - loadAcquire(sqHead) == sqEntries) return nullptr;
+            }
+
+            unsigned index = localTail & sqMask;
+            io_uring_sqe* sqe = &sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqArray[index] = index;
+            ++localTail;
+            ++pending;
+            return sqe;
+        }
+
+        // Makes queued SQEs visible to the kernel; they are filled in by then.
+        void publish() noexcept
+        {
+            storeRelease(sqTail, localTail);
+        }
+
+        int flush() noexcept
+        {
+            if(pending == 0) return 0;
+
+            publish();
+            int res = enter(fd, pending, 0, 0, nullptr, 0);
+            if(res > 0) pending -= static_cast<unsigned>(res);
+            return res;
+        }
+
+        // Allocates a slot and an SQE together so a full ring never leaks a slot.
+        io_uring_sqe* prepare(Target target, uint8_t opcode, Operation operation, uint64_t userData, uint32_t& index) noexcept
+        {
+            index = allocate(userData, operation);
+            if(index == NoSlot) return nullptr;
+
+            io_uring_sqe* sqe = acquire();
+            if(sqe == nullptr)
+            {
+                release(index);
+                return nullptr;
+            }
+
+            sqe->opcode = opcode;
+            sqe->fd = target.value;
+            if(target.fixed) sqe->flags |= IOSQE_FIXED_FILE;
+            sqe->user_data = pack(index, slots[index].generation);
+            return sqe;
+        }
+    };
+
+    CompletionEngine::CompletionEngine() : CompletionEngine(Config{})
+    {
+    }
+
+    CompletionEngine::CompletionEngine(Config config) : ring(std::make_unique<Ring>())
+    {
+        if(config.entries == 0) config.entries = 1;
+        if(config.maxOperations == 0) config.maxOperations = 1;
+
+        io_uring_params params{};
+        ring->fd = setup(config.entries, &params);
+        if(ring->fd < 0) throw std::system_error(errno, std::generic_category(), "io_uring_setup()");
+        ring->features = params.features;
+#if defined(IORING_CQE_F_NOTIF)
+        ring->sendZeroCopy = opcodeSupported(ring->fd, IORING_OP_SEND_ZC);
+#endif
+
+        ring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if(single) ring->sqMapSize = ring->cqMapSize = std::max(ring->sqMapSize, ring->cqMapSize);
+
+        ring->sqMap = ::mmap(nullptr, ring->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if(ring->sqMap == MAP_FAILED)
+        {
+            ring->sqMap = nullptr;
+            throw std::system_error(errno, std::generic_category(), "mmap()");
+        }
+
+        if(single)
+        {
+            ring->cqMap = ring->sqMap;
+        }
+        else
+        {
+            ring->cqMap = ::mmap(nullptr, ring->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+            if(ring->cqMap == MAP_FAILED)
+            {
+                ring->cqMap = nullptr;
+                throw std::system_error(errno, std::generic_category(), "mmap()");
+            }
+        }
+
+        ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+        if(sqes == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "mmap()");
+        ring->sqes = static_cast<io_uring_sqe*>(sqes);
+
+        std::byte* sq = static_cast<std::byte*>(ring->sqMap);
+        ring->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        ring->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        ring->sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        ring->sqEntries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+        ring->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        ring->localTail = *ring->sqTail;
+
+        std::byte* cq = static_cast<std::byte*>(ring->cqMap);
+        ring->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        ring->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        ring->cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        ring->slots.resize(config.maxOperations);
+        for(uint32_t i = config.maxOperations; i-- > 0;)
+        {
+            Ring::Slot& slot = ring->slots[i];
+            slot.active = false;
+            slot.generation = 0;
+            slot.nextFree = ring->freeSlot;
+            ring->freeSlot = i;
+        }
+    }
+
+    CompletionEngine::~CompletionEngine() noexcept = default;
+
+    bool CompletionEngine::supported() noexcept
+    {
+        io_uring_params params{};
+        int fd = setup(1, &params);
+        if(fd < 0) return false;
+        ::close(fd);
+        return true;
+    }
+
+    bool CompletionEngine::send(Target target, void const * data, size_t size, uint64_t userData) noexcept
+    {
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_SEND, Operation::Send, userData, index);
+        if(sqe == nullptr) return false;
+
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(size);
+        sqe->msg_flags = MSG_NOSIGNAL;
+        return true;
+    }
+
+    bool CompletionEngine::recv(Target target, void * data, size_t size, uint64_t userData) noexcept
+    {
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_RECV, Operation::Recv, userData, index);
+        if(sqe == nullptr) return false;
+
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(size);
+        return true;
+    }
+
+    bool CompletionEngine::sendTo(Target target, Endpoint const & peer, void const * data, size_t size, uint64_t userData) noexcept
+    {
+        SocketAddress addr;
+        if(!toSocketAddress(peer, addr)) return false;
+
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_SENDMSG, Operation::SendTo, userData, index);
+        if(sqe == nullptr) return false;
+
+        Ring::Slot& slot = ring->slots[index];
+        slot.addr = addr;
+        slot.iov.iov_base = const_cast<void*>(data);
+        slot.iov.iov_len = size;
+        std::memset(&slot.msg, 0, sizeof(slot.msg));
+        slot.msg.msg_name = slot.addr.data();
+        slot.msg.msg_namelen = slot.addr.length;
+        slot.msg.msg_iov = &slot.iov;
+        slot.msg.msg_iovlen = 1;
+
+        sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+        sqe->len = 1;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        return true;
+    }
+
+    bool CompletionEngine::recvFrom(Target target, void * data, size_t size, uint64_t userData) noexcept
+    {
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_RECVMSG, Operation::RecvFrom, userData, index);
+        if(sqe == nullptr) return false;
+
+        Ring::Slot& slot = ring->slots[index];
+        slot.iov.iov_base = data;
+        slot.iov.iov_len = size;
+        std::memset(&slot.msg, 0, sizeof(slot.msg));
+        slot.msg.msg_name = slot.addr.data();
+        slot.msg.msg_namelen = SocketAddress::capacity();
+        slot.msg.msg_iov = &slot.iov;
+        slot.msg.msg_iovlen = 1;
+
+        sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+        sqe->len = 1;
+        return true;
+    }
+
+    bool CompletionEngine::accept(Target target, uint64_t userData, bool multishot) noexcept
+    {
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_ACCEPT, Operation::Accept, userData, index);
+        if(sqe == nullptr) return false;
+
+        // Left blocking: io_uring fails operations on non-blocking sockets with EAGAIN
+        // instead of waiting for readiness.
+        sqe->accept_flags = SOCK_CLOEXEC;
+        if(multishot) sqe->ioprio |= IORING_ACCEPT_MULTISHOT;
+        return true;
+    }
+
+    bool CompletionEngine::recvMultishot(Target target, uint16_t group, uint64_t userData) noexcept
+    {
+        if(group >= ring->groups.size() || ring->groups[group].ring == nullptr) return false;
+
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_RECV, Operation::Recv, userData, index);
+        if(sqe == nullptr) return false;
+
+        ring->slots[index].group = group;
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        sqe->buf_group = group;
+        sqe->ioprio |= IORING_RECV_MULTISHOT;
+        return true;
+    }
+
+    bool CompletionEngine::poll(Target target, Event interest, uint64_t userData) noexcept
+    {
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_POLL_ADD, Operation::Poll, userData, index);
+        if(sqe == nullptr) return false;
+
+        uint32_t events = 0;
+        if(has(interest, Event::Read)) events |= POLLIN;
+        if(has(interest, Event::Write)) events |= POLLOUT;
+        sqe->poll32_events = events;
+        return true;
+    }
+
+    bool CompletionEngine::sendFixed(Target target, unsigned bufferIndex, size_t offset, size_t size, uint64_t userData) noexcept
+    {
+        if(bufferIndex >= ring->fixedBuffers.size()) return false;
+
+        iovec const & buffer = ring->fixedBuffers[bufferIndex];
+        if(offset > buffer.iov_len || size > buffer.iov_len - offset) return false;
+
+        // Not IORING_OP_WRITE_FIXED: a write to a reset socket raises SIGPIPE. Only the
+        // zero-copy send takes a registered buffer; before it, a plain send of the same
+        // bytes pins their pages per operation.
+        uint8_t opcode = IORING_OP_SEND;
+#if defined(IORING_CQE_F_NOTIF)
+        if(ring->sendZeroCopy) opcode = IORING_OP_SEND_ZC;
+#endif
+
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, opcode, Operation::SendFixed, userData, index);
+        if(sqe == nullptr) return false;
+
+        sqe->addr = reinterpret_cast<uint64_t>(buffer.iov_base) + offset;
+        sqe->len = static_cast<uint32_t>(size);
+        sqe->msg_flags = MSG_NOSIGNAL;
+#if defined(IORING_CQE_F_NOTIF)
+        if(opcode == IORING_OP_SEND_ZC)
+        {
+            sqe->ioprio |= IORING_RECVSEND_FIXED_BUF;
+            sqe->buf_index = static_cast<uint16_t>(bufferIndex);
+        }
+#endif
+        return true;
+    }
+
+    bool CompletionEngine::recvFixed(Target target, unsigned bufferIndex, size_t offset, size_t size, uint64_t userData) noexcept
+    {
+        if(bufferIndex >= ring->fixedBuffers.size()) return false;
+
+        iovec const & buffer = ring->fixedBuffers[bufferIndex];
+        if(offset > buffer.iov_len || size > buffer.iov_len - offset) return false;
+
+        uint32_t index;
+        io_uring_sqe* sqe = ring->prepare(target, IORING_OP_READ_FIXED, Operation::RecvFixed, userData, index);
+        if(sqe == nullptr) return false;
+
+        sqe->addr = reinterpret_cast<uint64_t>(buffer.iov_base) + offset;
+        sqe->len = static_cast<uint32_t>(size);
+        sqe->buf_index = static_cast<uint16_t>(bufferIndex);
+        return true;
+    }
+
+    bool CompletionEngine::cancel(uint64_t userData) noexcept
+    {
+        bool queued = false;
+        for(uint32_t i = 0; i < ring->slots.size(); ++i)
+        {
+            Ring::Slot const & slot = ring->slots[i];
+            if(!slot.active || slot.userData != userData || slot.operation == Operation::Cancel) continue;
+
+            uint32_t index;
+            io_uring_sqe* sqe = ring->prepare(Target(-1), IORING_OP_ASYNC_CANCEL, Operation::Cancel, userData, index);
+            if(sqe == nullptr) return queued;
+
+            sqe->addr = pack(i, slot.generation);
+            queued = true;
+        }
+        return queued;
+    }
+
+    bool CompletionEngine::registerBuffers(std::span<MutableBufferView const> buffers) noexcept
+    {
+        std::vector<iovec> iov;
+        try
+        {
+            iov.resize(buffers.size());
+        }
+        catch(...)
+        {
+            return false;
+        }
+
+        for(size_t i = 0; i < buffers.size(); ++i)
+        {
+            iov[i].iov_base = buffers[i].data;
+            iov[i].iov_len = buffers[i].size;
+        }
+
+        if(!ring->fixedBuffers.empty()) registerResource(ring->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        ring->fixedBuffers.clear();
+
+        if(registerResource(ring->fd, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(iov.size())) < 0) return false;
+        ring->fixedBuffers.swap(iov);
+        return true;
+    }
+
+    bool CompletionEngine::registerFiles(std::span<SocketFD const> fds) noexcept
+    {
+        return registerResource(ring->fd, IORING_REGISTER_FILES, fds.data(), static_cast<unsigned>(fds.size())) >= 0;
+    }
+
+    bool CompletionEngine::provideBuffers(uint16_t group, uint16_t count, size_t size) noexcept
+    {
+        if(count == 0 || (count & (count - 1)) != 0 || size == 0) return false;
+
+        try
+        {
+            if(group >= ring->groups.size()) ring->groups.resize(group + 1);
+        }
+        catch(...)
+        {
+            return false;
+        }
+
+        Ring::BufferGroup& entry = ring->groups[group];
+        if(entry.ring != nullptr) return false;
+
+        size_t ringBytes = count * sizeof(io_uring_buf);
+        void* memory = ::mmap(nullptr, ringBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(memory == MAP_FAILED) return false;
+
+        std::byte* buffers = new (std::nothrow) std::byte[count * size];
+        if(buffers == nullptr)
+        {
+            ::munmap(memory, ringBytes);
+            return false;
+        }
+
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(memory);
+        reg.ring_entries = count;
+        reg.bgid = group;
+        if(registerResource(ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+        {
+            delete[] buffers;
+            ::munmap(memory, ringBytes);
+            return false;
+        }
+
+        entry.ring = static_cast<io_uring_buf_ring*>(memory);
+        entry.ringBytes = ringBytes;
+        entry.memory = buffers;
+        entry.size = size;
+        entry.count = count;
+        entry.tail = 0;
+
+        for(uint16_t i = 0; i < count; ++i) recycle(group, i);
+        return true;
+    }
+
+    void CompletionEngine::recycle(uint16_t group, uint16_t bufferId) noexcept
+    {
+        if(group >= ring->groups.size() || ring->groups[group].ring == nullptr) return;
+
+        Ring::BufferGroup& entry = ring->groups[group];
+
+        // Not entry.ring->bufs: the header's flexible-array wrapper holds an empty struct,
+        // which is one byte in C++ and shifts the array away from the kernel's layout.
+        io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(entry.ring)[entry.tail & (entry.count - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(entry.memory + bufferId * entry.size);
+        buf.len = static_cast<uint32_t>(entry.size);
+        buf.bid = bufferId;
+
+        ++entry.tail;
+        storeRelease(&entry.ring->tail, entry.tail);
+    }
+
+    size_t CompletionEngine::submit() noexcept
+    {
+        int res = ring->flush();
+        return res > 0 ? static_cast<size_t>(res) : 0;
+    }
+
+    size_t CompletionEngine::run(int timeoutMs, Handler const & handler)
+    {
+        unsigned head = *ring->cqHead;
+        bool ready = head != loadAcquire(ring->cqTail);
+
+        if(!ready && timeoutMs != 0)
+        {
+            __kernel_timespec ts{};
+            io_uring_getevents_arg arg{};
+            unsigned flags = IORING_ENTER_GETEVENTS;
+            void const * argp = nullptr;
+            size_t argSize = 0;
+
+            if(timeoutMs > 0 && (ring->features & IORING_FEAT_EXT_ARG) != 0)
+            {
+                ts.tv_sec = timeoutMs / 1000;
+                ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+                flags |= IORING_ENTER_EXT_ARG;
+                argp = &arg;
+                argSize = sizeof(arg);
+            }
+            else if(timeoutMs > 0)
+            {
+                // Before 5.11 the wait itself can't time out: queue a timeout that
+                // completes after timeoutMs or with the first other completion, whichever
+                // comes first. Its own completion is skipped below.
+                io_uring_sqe* sqe = ring->acquire();
+                if(sqe == nullptr) throw std::system_error(EBUSY, std::generic_category(), "io_uring_enter()");
+
+                ring->timeout.tv_sec = timeoutMs / 1000;
+                ring->timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+                sqe->opcode = IORING_OP_TIMEOUT;
+                sqe->fd = -1;
+                sqe->addr = reinterpret_cast<uint64_t>(&ring->timeout);
+                sqe->len = 1;
+                sqe->off = 1;
+                sqe->user_data = TimeoutToken;
+            }
+
+            ring->publish();
+            int res = enter(ring->fd, ring->pending, 1, flags, argp, argSize);
+            if(res < 0)
+            {
+                if(errno != ETIME && errno != EINTR && errno != EBUSY) throw std::system_error(errno, std::generic_category(), "io_uring_enter()");
+            }
+            else
+            {
+                ring->pending -= std::min(ring->pending, static_cast<unsigned>(res));
+            }
+        }
+        else
+        {
+            ring->flush();
+        }
+
+        size_t delivered = 0;
+        unsigned tail = loadAcquire(ring->cqTail);
+        while(head != tail)
+        {
+            io_uring_cqe const & cqe = ring->cqes[head & ring->cqMask];
+            uint32_t index = static_cast<uint32_t>(cqe.user_data);
+            uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32);
+            int res = cqe.res;
+            unsigned flags = cqe.flags;
+            ++head;
+            storeRelease(ring->cqHead, head);
+
+            if(index >= ring->slots.size() || !ring->slots[index].active || ring->slots[index].generation != generation) continue;
+
+            Ring::Slot& slot = ring->slots[index];
+
+#if defined(IORING_CQE_F_NOTIF)
+            // A zero-copy send completes twice: with its result, and once the kernel no
+            // longer reads the buffer. Only the second one is delivered.
+            if(slot.operation == Operation::SendFixed)
+            {
+                if(flags & IORING_CQE_F_NOTIF)
+                {
+                    res = slot.sent;
+                    flags = 0;
+                }
+                else if(flags & IORING_CQE_F_MORE)
+                {
+                    slot.sent = res;
+                    continue;
+                }
+            }
+#endif
+
+            Completion completion{};
+            completion.userData = slot.userData;
+            completion.operation = slot.operation;
+            completion.result = toResult(slot.operation, res);
+            completion.more = (flags & IORING_CQE_F_MORE) != 0;
+
+            switch(slot.operation)
+            {
+            case Operation::Accept:
+                if(res >= 0) completion.accepted = res;
+                break;
+            case Operation::RecvFrom:
+                if(res >= 0) completion.peer = fromSocketAddress(slot.addr.data(), slot.msg.msg_namelen);
+                break;
+            case Operation::Poll:
+                if(res >= 0)
+                {
+                    if(res & POLLIN) completion.events = completion.events | Event::Read;
+                    if(res & POLLOUT) completion.events = completion.events | Event::Write;
+                    if(res & (POLLERR | POLLNVAL)) completion.events = completion.events | Event::Error;
+                    if(res & POLLHUP) completion.events = completion.events | Event::Hangup;
+                }
+                break;
+            case Operation::Recv:
+                if(flags & IORING_CQE_F_BUFFER)
+                {
+                    completion.bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+                    Ring::BufferGroup const & group = ring->groups[slot.group];
+                    completion.buffer = group.memory + completion.bufferId * group.size;
+                }
+                break;
+            default:
+                break;
+            }
+
+            if(!completion.more) ring->release(index);
+
+            handler(completion);
+            ++delivered;
+
+            tail = loadAcquire(ring->cqTail);
+        }
+
+        return delivered;
+    }
+
+    size_t CompletionEngine::inFlight() const noexcept
+    {
+        return ring->active;
+    }
+
+    SocketFD CompletionEngine::native() const noexcept
+    {
+        return ring->fd;
+    }
+#else
+    struct CompletionEngine::Ring
+    {
+    };
+
+    CompletionEngine::CompletionEngine() : CompletionEngine(Config{})
+    {
+    }
+
+    CompletionEngine::CompletionEngine(Config)
+    {
+        throw std::system_error(ENOSYS, std::generic_category(), "io_uring_setup()");
+    }
+
+    CompletionEngine::~CompletionEngine() noexcept = default;
+
+    bool CompletionEngine::supported() noexcept { return false; }
+    bool CompletionEngine::send(Target, void const *, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::recv(Target, void *, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::sendTo(Target, Endpoint const &, void const *, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::recvFrom(Target, void *, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::accept(Target, uint64_t, bool) noexcept { return false; }
+    bool CompletionEngine::recvMultishot(Target, uint16_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::poll(Target, Event, uint64_t) noexcept { return false; }
+    bool CompletionEngine::sendFixed(Target, unsigned, size_t, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::recvFixed(Target, unsigned, size_t, size_t, uint64_t) noexcept { return false; }
+    bool CompletionEngine::cancel(uint64_t) noexcept { return false; }
+    bool CompletionEngine::registerBuffers(std::span<MutableBufferView const>) noexcept { return false; }
+    bool CompletionEngine::registerFiles(std::span<SocketFD const>) noexcept { return false; }
+    bool CompletionEngine::provideBuffers(uint16_t, uint16_t, size_t) noexcept { return false; }
+    void CompletionEngine::recycle(uint16_t, uint16_t) noexcept {}
+    size_t CompletionEngine::submit() noexcept { return 0; }
+    size_t CompletionEngine::run(int, Handler const &) { return 0; }
+    size_t CompletionEngine::inFlight() const noexcept { return 0; }
+    SocketFD CompletionEngine::native() const noexcept { return -1; }
+#endif
+}
\ No newline at end of file
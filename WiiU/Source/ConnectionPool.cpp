@@ -0,0 +1,233 @@
+#include "Network/ConnectionPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Library::Network
+{
+    Lease::Lease() noexcept : pool(nullptr), warm(false)
+    {
+    }
+
+    Lease::Lease(ConnectionPool* pool, Endpoint const & peer, TcpSocket socket, bool warm) noexcept :
+        pool(pool),
+        peer(peer),
+        connection(std::move(socket)),
+        warm(warm)
+    {
+    }
+
+    Lease::~Lease() noexcept
+    {
+        release();
+    }
+
+    Lease::Lease(Lease&& other) noexcept :
+        pool(std::exchange(other.pool, nullptr)),
+        peer(other.peer),
+        connection(std::move(other.connection)),
+        warm(other.warm)
+    {
+        other.connection.reset();
+    }
+
+    Lease& Lease::operator=(Lease&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            pool = std::exchange(other.pool, nullptr);
+            peer = other.peer;
+            connection = std::move(other.connection);
+            warm = other.warm;
+            other.connection.reset();
+        }
+        return *this;
+    }
+
+    void Lease::discard() noexcept
+    {
+        connection.reset();
+        release();
+    }
+
+    void Lease::release() noexcept
+    {
+        if(pool == nullptr) return;
+
+        std::exchange(pool, nullptr)->giveBack(peer, std::move(connection));
+        connection.reset();
+    }
+
+    ConnectionPool::ConnectionPool() : ConnectionPool(Config{})
+    {
+    }
+
+    ConnectionPool::ConnectionPool(Config config) : config(config)
+    {
+        if(this->config.maxPerHost == 0) this->config.maxPerHost = 1;
+    }
+
+    ConnectionPool::~ConnectionPool() noexcept = default;
+
+    Lease ConnectionPool::acquire(Endpoint const & endpoint, int waitMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        Host& host = hosts[endpoint];
+
+        if(host.leased >= config.maxPerHost)
+        {
+            auto available = [&]
+            {
+                return host.leased < config.maxPerHost;
+            };
+
+            // prune() and clear() leave a host alone while anyone waits on it.
+            ++host.waiters;
+            bool ready = true;
+            if(waitMs < 0) returned.wait(lock, available);
+            else ready = returned.wait_for(lock, std::chrono::milliseconds(waitMs), available);
+            --host.waiters;
+            if(!ready) return Lease();
+        }
+
+        ++host.leased;
+        if(std::optional<TcpSocket> socket = takeIdle(host)) return Lease(this, endpoint, std::move(*socket), true);
+        lock.unlock();
+
+        // Connect without holding the lock; the slot is already reserved.
+        std::optional<TcpSocket> socket;
+        try
+        {
+            AddressFamily family = endpoint.family() == AddressFamily::IPv6 ? AddressFamily::IPv6 : AddressFamily::IPv4;
+            socket.emplace(family, false, config.options);
+        }
+        catch(...)
+        {
+            giveBack(endpoint, std::nullopt);
+            throw;
+        }
+
+        if(!socket->connect(endpoint, config.connectTimeoutMs))
+        {
+            giveBack(endpoint, std::nullopt);
+            return Lease();
+        }
+
+        return Lease(this, endpoint, std::move(*socket), false);
+    }
+
+    Lease ConnectionPool::tryAcquire(Endpoint const & endpoint)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = hosts.find(endpoint);
+        if(it == hosts.end() || it->second.leased >= config.maxPerHost) return Lease();
+
+        std::optional<TcpSocket> socket = takeIdle(it->second);
+        if(!socket) return Lease();
+
+        ++it->second.leased;
+        return Lease(this, endpoint, std::move(*socket), true);
+    }
+
+    size_t ConnectionPool::idle(Endpoint const & endpoint) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = hosts.find(endpoint);
+        return it == hosts.end() ? 0 : it->second.idle.size();
+    }
+
+    size_t ConnectionPool::leased(Endpoint const & endpoint) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = hosts.find(endpoint);
+        return it == hosts.end() ? 0 : it->second.leased;
+    }
+
+    size_t ConnectionPool::prune()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Clock::time_point now = Clock::now();
+        size_t closed = 0;
+        for(auto it = hosts.begin(); it != hosts.end();)
+        {
+            std::vector<Idle>& idle = it->second.idle;
+            size_t before = idle.size();
+            std::erase_if(idle, [&](Idle& item)
+            {
+                return now - item.since >= config.idleTimeout || !healthy(item.socket);
+            });
+            closed += before - idle.size();
+
+            // A waiter in acquire() holds a reference to its host; only drop unused ones.
+            if(idle.empty() && it->second.leased == 0 && it->second.waiters == 0) it = hosts.erase(it);
+            else ++it;
+        }
+        return closed;
+    }
+
+    void ConnectionPool::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for(auto it = hosts.begin(); it != hosts.end();)
+        {
+            it->second.idle.clear();
+            if(it->second.leased == 0 && it->second.waiters == 0) it = hosts.erase(it);
+            else ++it;
+        }
+    }
+
+    std::optional<TcpSocket> ConnectionPool::takeIdle(Host& host)
+    {
+        Clock::time_point now = Clock::now();
+        while(!host.idle.empty())
+        {
+            Idle item = std::move(host.idle.back());
+            host.idle.pop_back();
+
+            if(now - item.since >= config.idleTimeout) continue;
+            if(!healthy(item.socket)) continue;
+
+            return std::move(item.socket);
+        }
+        return std::nullopt;
+    }
+
+    void ConnectionPool::giveBack(Endpoint const & endpoint, std::optional<TcpSocket> socket) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = hosts.find(endpoint);
+            if(it != hosts.end())
+            {
+                Host& host = it->second;
+                --host.leased;
+
+                if(socket && host.idle.size() < config.maxIdlePerHost)
+                {
+                    try
+                    {
+                        host.idle.push_back({std::move(*socket), Clock::now()});
+                    }
+                    catch(...)
+                    {
+                    }
+                }
+            }
+        }
+        returned.notify_all();
+    }
+
+    bool ConnectionPool::healthy(TcpSocket& socket) noexcept
+    {
+        // Nothing should arrive on an idle connection: readable means the peer closed
+        // it (recv would report Disconnected) or sent bytes nobody asked for.
+        return !socket.waitRead(0);
+    }
+}
\ No newline at end of file
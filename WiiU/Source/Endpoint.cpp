@@ -0,0 +1,107 @@
+#include "Network/Endpoint.hpp"
+#include "Network/Platform.hpp"
+
+#if defined(__linux__)
+#include <net/if.h>
+#endif
+
+#include <charconv>
+#include <cstring>
+
+namespace Library::Network
+{
+    std::optional<Endpoint> Endpoint::parse(std::string_view host, uint16_t port) noexcept
+    {
+        char text[64];
+        if(host.empty() || host.size() >= sizeof(text)) return std::nullopt;
+        std::memcpy(text, host.data(), host.size());
+        text[host.size()] = '\0';
+
+        in_addr v4;
+        if(::inet_pton(AF_INET, text, &v4) == 1)
+        {
+            return Endpoint::ipv4(ntohl(v4.s_addr), port);
+        }
+
+#if defined(NETWORK_HAS_IPV6)
+        // Link-local addresses carry their interface as "fe80::1%2" or "fe80::1%eth0".
+        uint32_t scopeId = 0;
+        if(char* percent = std::strchr(text, '%'))
+        {
+            *percent = '\0';
+            char const * scope = percent + 1;
+            char const * end = text + host.size();
+            auto [last, error] = std::from_chars(scope, end, scopeId);
+            if(error != std::errc() || last != end)
+            {
+#if defined(__linux__)
+                scopeId = ::if_nametoindex(scope);
+                if(scopeId == 0) return std::nullopt;
+#else
+                return std::nullopt;
+#endif
+            }
+        }
+
+        in6_addr v6;
+        if(::inet_pton(AF_INET6, text, &v6) == 1)
+        {
+            Bytes bytes;
+            std::memcpy(bytes.data(), &v6, bytes.size());
+            return Endpoint::ipv6(bytes, port, scopeId);
+        }
+#endif
+
+        return std::nullopt;
+    }
+
+    std::string Endpoint::address() const
+    {
+        char text[64];
+        switch(addressFamily)
+        {
+        case AddressFamily::IPv4:
+            if(::inet_ntop(AF_INET, addressBytes.data(), text, sizeof(text)) == nullptr) return {};
+            return text;
+#if defined(NETWORK_HAS_IPV6)
+        case AddressFamily::IPv6:
+            if(::inet_ntop(AF_INET6, addressBytes.data(), text, sizeof(text)) == nullptr) return {};
+            if(scope != 0) return std::string(text) + '%' + std::to_string(scope);
+            return text;
+#endif
+        default:
+            return {};
+        }
+    }
+
+    std::string Endpoint::toString() const
+    {
+        bool bracketed = addressFamily == AddressFamily::IPv6;
+        std::string host = address();
+
+        std::string text;
+        text.reserve(host.size() + 8);
+        if(bracketed) text += '[';
+        text += host;
+        if(bracketed) text += ']';
+        text += ':';
+        text += std::to_string(portNumber);
+        return text;
+    }
+
+    size_t Endpoint::hash() const noexcept
+    {
+        uint64_t high;
+        uint64_t low;
+        std::memcpy(&high, addressBytes.data(), sizeof(high));
+        std::memcpy(&low, addressBytes.data() + sizeof(high), sizeof(low));
+
+        uint64_t h = high * 0x9E3779B97F4A7C15ull;
+        h ^= low + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        h ^= (static_cast<uint64_t>(portNumber) << 40) | (static_cast<uint64_t>(addressFamily) << 32) | scope;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,492 @@
+#include "Network/EventLoop.hpp"
+#include "Network/Platform.hpp"
+#include "Network/TimerWheel.hpp"
+
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace Library::Network
+{
+    namespace
+    {
+        constexpr size_t InitialEventCapacity = 256;
+
+#if defined(__linux__)
+        constexpr uint64_t WakeToken = ~uint64_t(0);
+        constexpr size_t MaxEventCapacity = 65536;
+#endif
+
+        short toPoll(Event interest) noexcept
+        {
+            short events = 0;
+            if(has(interest, Event::Read)) events |= POLLIN;
+            if(has(interest, Event::Write)) events |= POLLOUT;
+            return events;
+        }
+
+        Event fromPoll(short revents) noexcept
+        {
+            Event events = Event::None;
+            if(revents & POLLIN) events = events | Event::Read;
+            if(revents & POLLOUT) events = events | Event::Write;
+            if(revents & (POLLERR | POLLNVAL)) events = events | Event::Error;
+            if(revents & POLLHUP) events = events | Event::Hangup;
+            return events;
+        }
+
+#if defined(__linux__)
+        uint32_t toEpoll(Event interest) noexcept
+        {
+            uint32_t events = 0;
+            if(has(interest, Event::Read)) events |= EPOLLIN | EPOLLRDHUP;
+            if(has(interest, Event::Write)) events |= EPOLLOUT;
+            return events;
+        }
+
+        Event fromEpoll(uint32_t revents) noexcept
+        {
+            Event events = Event::None;
+            if(revents & EPOLLIN) events = events | Event::Read;
+            if(revents & EPOLLOUT) events = events | Event::Write;
+            if(revents & EPOLLERR) events = events | Event::Error;
+            if(revents & (EPOLLHUP | EPOLLRDHUP)) events = events | Event::Hangup;
+            return events;
+        }
+
+        uint64_t pack(SocketFD fd, uint32_t generation) noexcept
+        {
+            return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+        }
+#endif
+    }
+
+    struct EventLoop::Poller
+    {
+        SocketFD wakeFd = Platform::Invalid;
+#if defined(__linux__)
+        int epollFd = -1;
+        std::vector<epoll_event> events;
+#endif
+        // Poll backend only. Slot 0 is always the wake descriptor.
+        std::vector<Platform::PollDescriptor> pollFds;
+
+        ~Poller() noexcept
+        {
+#if defined(__linux__)
+            if(epollFd >= 0) ::close(epollFd);
+#endif
+            if(Platform::valid(wakeFd)) Platform::close(wakeFd);
+        }
+
+        void openWake()
+        {
+#if defined(__linux__)
+            wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if(wakeFd < 0) throw Platform::failure("eventfd()");
+#else
+            // No eventfd/pipe everywhere: a loopback datagram socket connected to itself.
+            wakeFd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if(!Platform::valid(wakeFd)) throw Platform::failure("socket()");
+
+            sockaddr_in addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+
+            int res = ::bind(wakeFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            if(res < 0) throw Platform::failure("bind()");
+
+            Platform::Length size = sizeof(addr);
+            res = ::getsockname(wakeFd, reinterpret_cast<sockaddr*>(&addr), &size);
+            if(res < 0) throw Platform::failure("getsockname()");
+
+            res = ::connect(wakeFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            if(res < 0) throw Platform::failure("connect()");
+
+            if(!Platform::setNonBlocking(wakeFd, true)) throw Platform::failure("setNonBlocking()");
+#endif
+        }
+
+        void signal() noexcept
+        {
+#if defined(__linux__)
+            uint64_t one = 1;
+            [[maybe_unused]] ssize_t res = ::write(wakeFd, &one, sizeof(one));
+#else
+            uint8_t one = 1;
+            Platform::send(wakeFd, &one, sizeof(one), 0);
+#endif
+        }
+
+        void drain() noexcept
+        {
+#if defined(__linux__)
+            uint64_t value;
+            [[maybe_unused]] ssize_t res = ::read(wakeFd, &value, sizeof(value));
+#else
+            uint8_t buffer[64];
+            while(Platform::recv(wakeFd, buffer, sizeof(buffer), 0) > 0) {}
+#endif
+        }
+    };
+
+    EventLoop::EventLoop(Backend backend) :
+        type(backend),
+        poller(std::make_unique<Poller>()),
+        nextGeneration(0),
+        dispatching(false),
+        count(0),
+        stopRequested(false),
+        wakePending(false),
+        wheel(std::make_unique<TimerWheel>(TimerWheel::Clock::now()))
+    {
+        if(type == Backend::Default) type = Platform::HasEpoll ? Backend::Epoll : Backend::Poll;
+        if(type == Backend::Epoll && !Platform::HasEpoll) throw std::logic_error("epoll backend is unavailable");
+
+        poller->openWake();
+
+#if defined(__linux__)
+        if(type == Backend::Epoll)
+        {
+            poller->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            if(poller->epollFd < 0) throw Platform::failure("epoll_create1()");
+
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u64 = WakeToken;
+            int res = ::epoll_ctl(poller->epollFd, EPOLL_CTL_ADD, poller->wakeFd, &ev);
+            if(res < 0) throw Platform::failure("epoll_ctl()");
+
+            poller->events.resize(InitialEventCapacity);
+        }
+#endif
+
+        if(type == Backend::Poll)
+        {
+            poller->pollFds.push_back({poller->wakeFd, POLLIN, 0});
+        }
+
+        ready.reserve(InitialEventCapacity);
+    }
+
+    EventLoop::~EventLoop() noexcept = default;
+
+    bool EventLoop::add(SocketFD fd, Event interest, Callback callback)
+    {
+        if(!Platform::valid(fd) || !callback) return false;
+
+        size_t index = static_cast<size_t>(fd);
+        if(index >= entries.size()) entries.resize(index + 1);
+        if(entries[index]) return false;
+
+        uint32_t generation = ++nextGeneration;
+        auto entry = std::make_unique<Entry>(Entry{std::move(callback), interest, generation, 0});
+
+#if defined(__linux__)
+        if(type == Backend::Epoll)
+        {
+            epoll_event ev{};
+            ev.events = toEpoll(interest);
+            ev.data.u64 = pack(fd, generation);
+            int res = ::epoll_ctl(poller->epollFd, EPOLL_CTL_ADD, fd, &ev);
+            if(res < 0) return false;
+        }
+#endif
+
+        if(type == Backend::Poll)
+        {
+            entry->pollIndex = poller->pollFds.size();
+            poller->pollFds.push_back({fd, toPoll(interest), 0});
+        }
+
+        entries[index] = std::move(entry);
+        ++count;
+        return true;
+    }
+
+    bool EventLoop::modify(SocketFD fd, Event interest) noexcept
+    {
+        if(!contains(fd)) return false;
+
+        Entry& entry = *entries[static_cast<size_t>(fd)];
+        if(entry.interest == interest) return true;
+
+#if defined(__linux__)
+        if(type == Backend::Epoll)
+        {
+            epoll_event ev{};
+            ev.events = toEpoll(interest);
+            ev.data.u64 = pack(fd, entry.generation);
+            int res = ::epoll_ctl(poller->epollFd, EPOLL_CTL_MOD, fd, &ev);
+            if(res < 0) return false;
+        }
+#endif
+
+        if(type == Backend::Poll)
+        {
+            poller->pollFds[entry.pollIndex].events = toPoll(interest);
+        }
+
+        entry.interest = interest;
+        return true;
+    }
+
+    bool EventLoop::remove(SocketFD fd)
+    {
+        if(!contains(fd)) return false;
+
+        std::unique_ptr<Entry>& slot = entries[static_cast<size_t>(fd)];
+
+#if defined(__linux__)
+        if(type == Backend::Epoll)
+        {
+            // The descriptor may already be closed, which removes it from the set anyway.
+            ::epoll_ctl(poller->epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+#endif
+
+        if(type == Backend::Poll)
+        {
+            std::vector<Platform::PollDescriptor>& pollFds = poller->pollFds;
+            size_t index = slot->pollIndex;
+            if(index != pollFds.size() - 1)
+            {
+                pollFds[index] = pollFds.back();
+                entries[static_cast<size_t>(pollFds[index].fd)]->pollIndex = index;
+            }
+            pollFds.pop_back();
+        }
+
+        // A callback may remove its own registration; keep it alive until dispatch ends.
+        if(dispatching) retired.push_back(std::move(slot));
+        else slot.reset();
+
+        --count;
+        return true;
+    }
+
+    bool EventLoop::contains(SocketFD fd) const noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+        size_t index = static_cast<size_t>(fd);
+        return index < entries.size() && entries[index];
+    }
+
+    Event EventLoop::interest(SocketFD fd) const noexcept
+    {
+        if(!contains(fd)) return Event::None;
+
+        return entries[static_cast<size_t>(fd)]->interest;
+    }
+
+    size_t EventLoop::runOnce(int timeoutMs)
+    {
+        wait(deferred.empty() ? timerTimeout(timeoutMs) : 0);
+
+        size_t dispatched = 0;
+        dispatching = true;
+        for(Ready const & item : ready)
+        {
+            size_t index = static_cast<size_t>(item.fd);
+            if(index >= entries.size()) continue;
+
+            Entry* entry = entries[index].get();
+            if(entry == nullptr || entry->generation != item.generation) continue;
+
+            Event events = item.events & (entry->interest | Event::Error | Event::Hangup);
+            if(events == Event::None) continue;
+
+            entry->callback(events);
+            ++dispatched;
+        }
+        dispatching = false;
+        retired.clear();
+
+        runTimers();
+        runPosted();
+        runDeferred();
+        return dispatched;
+    }
+
+    void EventLoop::run()
+    {
+        while(!stopRequested.load(std::memory_order_acquire))
+        {
+            runOnce(-1);
+        }
+        stopRequested.store(false, std::memory_order_release);
+    }
+
+    void EventLoop::stop() noexcept
+    {
+        stopRequested.store(true, std::memory_order_release);
+        wake();
+    }
+
+    void EventLoop::post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(postedMutex);
+            posted.push_back(std::move(job));
+        }
+        wake();
+    }
+
+    void EventLoop::defer(std::function<void()> job)
+    {
+        deferred.push_back(std::move(job));
+    }
+
+    EventLoop::TimerId EventLoop::runAfter(std::chrono::milliseconds delay, std::function<void()> job)
+    {
+        return wheel->add(TimerWheel::Clock::now(), delay, std::move(job));
+    }
+
+    bool EventLoop::cancelTimer(TimerId id) noexcept
+    {
+        return wheel->cancel(id);
+    }
+
+    bool EventLoop::rearmTimer(TimerId id, std::chrono::milliseconds delay) noexcept
+    {
+        return wheel->rearm(id, TimerWheel::Clock::now(), delay);
+    }
+
+    size_t EventLoop::timers() const noexcept
+    {
+        return wheel->size();
+    }
+
+    EventLoop::Backend EventLoop::backend() const noexcept
+    {
+        return type;
+    }
+
+    size_t EventLoop::size() const noexcept
+    {
+        return count;
+    }
+
+    int EventLoop::timerTimeout(int timeoutMs)
+    {
+        // Already rounded up, so the wait never returns just before the deadline.
+        int64_t ms = wheel->timeout(TimerWheel::Clock::now());
+        if(ms < 0) return timeoutMs;
+        if(timeoutMs >= 0 && timeoutMs < ms) return timeoutMs;
+        return static_cast<int>(std::min<int64_t>(ms, 0x7FFFFFFF));
+    }
+
+    void EventLoop::runTimers()
+    {
+        wheel->expire(TimerWheel::Clock::now(), expired);
+
+        // Collected first so a job re-arming itself with no delay waits for the next pass.
+        for(size_t i = 0; i < expired.size(); ++i) expired[i]();
+        expired.clear();
+    }
+
+    void EventLoop::wait(int timeoutMs)
+    {
+        ready.clear();
+
+#if defined(__linux__)
+        if(type == Backend::Epoll)
+        {
+            std::vector<epoll_event>& events = poller->events;
+
+            int res = ::epoll_wait(poller->epollFd, events.data(), static_cast<int>(events.size()), timeoutMs);
+            if(res < 0)
+            {
+                if(Platform::interrupted(Platform::lastError())) return;
+                throw Platform::failure("epoll_wait()");
+            }
+
+            size_t n = static_cast<size_t>(res);
+            for(size_t i = 0; i < n; ++i)
+            {
+                uint64_t data = events[i].data.u64;
+                if(data == WakeToken)
+                {
+                    // Drain before clearing: a wake() in between then signals afresh
+                    // instead of having its signal swallowed with the flag left set.
+                    poller->drain();
+                    wakePending.store(false, std::memory_order_release);
+                    continue;
+                }
+
+                SocketFD fd = static_cast<SocketFD>(data & 0xFFFFFFFFu);
+                uint32_t generation = static_cast<uint32_t>(data >> 32);
+                ready.push_back({fd, generation, fromEpoll(events[i].events)});
+            }
+
+            if(n == events.size() && n < MaxEventCapacity) events.resize(n * 2);
+            return;
+        }
+#endif
+
+        std::vector<Platform::PollDescriptor>& pollFds = poller->pollFds;
+
+        int res = Platform::poll(pollFds.data(), pollFds.size(), timeoutMs);
+        if(res < 0)
+        {
+            if(Platform::interrupted(Platform::lastError())) return;
+            throw Platform::failure("poll()");
+        }
+        if(res == 0) return;
+
+        if(pollFds[0].revents != 0)
+        {
+            poller->drain();
+            wakePending.store(false, std::memory_order_release);
+            --res;
+        }
+
+        for(size_t i = 1; i < pollFds.size() && res > 0; ++i)
+        {
+            Platform::PollDescriptor& pfd = pollFds[i];
+            if(pfd.revents == 0) continue;
+
+            --res;
+            Entry const & entry = *entries[static_cast<size_t>(pfd.fd)];
+            ready.push_back({pfd.fd, entry.generation, fromPoll(pfd.revents)});
+        }
+    }
+
+    void EventLoop::wake() noexcept
+    {
+        if(wakePending.exchange(true, std::memory_order_acq_rel)) return;
+        poller->signal();
+    }
+
+    void EventLoop::runPosted()
+    {
+        {
+            std::lock_guard<std::mutex> lock(postedMutex);
+            if(posted.empty()) return;
+            running.swap(posted);
+        }
+
+        for(auto& job : running) job();
+        running.clear();
+    }
+
+    void EventLoop::runDeferred()
+    {
+        if(deferred.empty()) return;
+
+        // Jobs deferred by these run on the next iteration.
+        runningDeferred.swap(deferred);
+        for(auto& job : runningDeferred) job();
+        runningDeferred.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "Network/FrameCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace Library::Network
+{
+    namespace
+    {
+        constexpr size_t MaxHeader = 8;
+    }
+
+    FrameCodec::FrameCodec() : FrameCodec(Config{})
+    {
+    }
+
+    FrameCodec::FrameCodec(Config config) :
+        config(std::move(config)),
+        begin(0),
+        end(0),
+        scanned(0),
+        needed(0)
+    {
+        if(this->config.framing == Framing::LengthPrefix)
+        {
+            if(this->config.prefixBytes == 0 || this->config.prefixBytes > MaxHeader) throw std::invalid_argument("prefixBytes must be 1..8");
+        }
+        else if(this->config.delimiter.empty())
+        {
+            throw std::invalid_argument("delimiter is empty");
+        }
+
+        if(this->config.bufferSize == 0) this->config.bufferSize = 1;
+    }
+
+    Result FrameCodec::receive(TcpSocket& socket) noexcept
+    {
+        if(!reserve()) return {ResultType::Error, 0};
+
+        Result res = socket.recv(buffer.data() + end, buffer.size() - end);
+        if(res.type == ResultType::Data) end += res.bytes;
+        return res;
+    }
+
+    MutableBufferView FrameCodec::writable() noexcept
+    {
+        if(!reserve()) return {nullptr, 0};
+        return {buffer.data() + end, buffer.size() - end};
+    }
+
+    void FrameCodec::commit(size_t size) noexcept
+    {
+        end += std::min(size, buffer.size() - end);
+    }
+
+    Result FrameCodec::next(ConstBufferView& frame) noexcept
+    {
+        size_t held = end - begin;
+        std::byte const * data = buffer.data() + begin;
+
+        if(config.framing == Framing::LengthPrefix)
+        {
+            size_t prefix = config.prefixBytes;
+            if(held < prefix) return {ResultType::WouldBlock, 0};
+
+            uint64_t length = 0;
+            for(size_t i = 0; i < prefix; ++i)
+            {
+                size_t index = config.order == ByteOrder::Big ? i : prefix - 1 - i;
+                length = (length << 8) | static_cast<uint8_t>(data[index]);
+            }
+            if(length > config.maxFrame) return {ResultType::Error, 0};
+
+            size_t total = prefix + static_cast<size_t>(length);
+            if(held < total)
+            {
+                needed = total;
+                return {ResultType::WouldBlock, 0};
+            }
+
+            frame = {data + prefix, static_cast<size_t>(length)};
+            begin += total;
+            needed = 0;
+            return {ResultType::Data, frame.size};
+        }
+
+        std::string_view delimiter = config.delimiter;
+        std::string_view text(reinterpret_cast<char const *>(data), held);
+
+        size_t found = text.find(delimiter, scanned);
+        if(found == std::string_view::npos)
+        {
+            // Keep the last partial delimiter in range for the next search.
+            if(held >= delimiter.size()) scanned = held - delimiter.size() + 1;
+            if(held > config.maxFrame + delimiter.size()) return {ResultType::Error, 0};
+            return {ResultType::WouldBlock, 0};
+        }
+        if(found > config.maxFrame) return {ResultType::Error, 0};
+
+        frame = {data, found};
+        begin += found + delimiter.size();
+        scanned = 0;
+        return {ResultType::Data, found};
+    }
+
+    size_t FrameCodec::buffered() const noexcept
+    {
+        return end - begin;
+    }
+
+    void FrameCodec::reset() noexcept
+    {
+        begin = end = scanned = needed = 0;
+    }
+
+    Result FrameCodec::send(TcpSocket& socket, std::span<ConstBufferView const> payload, size_t& written) const noexcept
+    {
+        if(payload.size() > MaxPayloadParts) return {ResultType::Error, 0};
+
+        size_t size = 0;
+        for(ConstBufferView const & part : payload) size += part.size;
+        if(config.framing == Framing::LengthPrefix)
+        {
+            if(size > config.maxFrame) return {ResultType::Error, 0};
+            if(config.prefixBytes < MaxHeader && (uint64_t(size) >> (config.prefixBytes * 8)) != 0) return {ResultType::Error, 0};
+        }
+
+        std::byte prefix[MaxHeader];
+        ConstBufferView views[MaxPayloadParts + 2];
+        size_t count = 0;
+
+        if(config.framing == Framing::LengthPrefix) views[count++] = {prefix, header(size, prefix)};
+        for(ConstBufferView const & part : payload) views[count++] = part;
+        if(config.framing == Framing::Delimiter) views[count++] = {config.delimiter.data(), config.delimiter.size()};
+
+        size_t total = wireSize(size);
+        while(written < total)
+        {
+            // Skip what earlier calls already sent.
+            size_t skip = written;
+            size_t first = 0;
+            while(skip >= views[first].size)
+            {
+                skip -= views[first].size;
+                ++first;
+            }
+
+            ConstBufferView head = views[first];
+            views[first] = {static_cast<std::byte const *>(head.data) + skip, head.size - skip};
+            Result res = socket.sendv(std::span<ConstBufferView const>(views + first, count - first));
+            views[first] = head;
+
+            if(res.type != ResultType::Data) return {res.type, 0};
+            written += res.bytes;
+        }
+
+        return {ResultType::Data, total};
+    }
+
+    Result FrameCodec::send(TcpSocket& socket, void const * data, size_t size, size_t& written) const noexcept
+    {
+        ConstBufferView part{data, size};
+        return send(socket, std::span<ConstBufferView const>(&part, 1), written);
+    }
+
+    size_t FrameCodec::header(size_t size, std::byte* out) const noexcept
+    {
+        if(config.framing != Framing::LengthPrefix) return 0;
+
+        size_t prefix = config.prefixBytes;
+        uint64_t length = size;
+        for(size_t i = 0; i < prefix; ++i)
+        {
+            size_t index = config.order == ByteOrder::Big ? prefix - 1 - i : i;
+            out[index] = static_cast<std::byte>(length & 0xFF);
+            length >>= 8;
+        }
+        return prefix;
+    }
+
+    size_t FrameCodec::wireSize(size_t size) const noexcept
+    {
+        if(config.framing == Framing::LengthPrefix) return config.prefixBytes + size;
+        return size + config.delimiter.size();
+    }
+
+    bool FrameCodec::reserve() noexcept
+    {
+        size_t held = end - begin;
+        if(held == 0)
+        {
+            begin = 0;
+            end = 0;
+        }
+
+        size_t want = std::max(needed, held + 1);
+        if(buffer.size() - begin >= want && end < buffer.size()) return true;
+
+        // Slide the partial frame to the front before growing.
+        if(begin > 0)
+        {
+            std::memmove(buffer.data(), buffer.data() + begin, held);
+            begin = 0;
+            end = held;
+        }
+        if(buffer.size() >= want && end < buffer.size()) return true;
+
+        // One frame plus its framing is the most the buffer ever has to hold.
+        size_t limit = wireSize(config.maxFrame) + 1;
+        try
+        {
+            buffer.resize(std::max({want, std::min(buffer.size() * 2, limit), config.bufferSize}));
+        }
+        catch(...)
+        {
+            return false;
+        }
+        return true;
+    }
+}
\ No newline at end of file
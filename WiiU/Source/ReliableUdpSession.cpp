@@ -0,0 +1,747 @@
+#include "Network/ReliableUdpSession.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Library::Network
+{
+    namespace
+    {
+        using Clock = ReliableUdpSession::Clock;
+        using Delivery = ReliableUdpSession::Delivery;
+
+        // Packet: magic, flags, sequence, acked sequence, ack bits, then records to the
+        // end. Record: channel, flags, payload length, message id, for fragments also
+        // index, count and message size, then the payload. Integers are big-endian.
+        constexpr uint8_t Magic = 0xB7;
+        constexpr uint8_t HasAck = 0x01;
+        constexpr uint8_t AckNow = 0x02;                    // receiver acks at once instead of after ackDelay
+        constexpr uint8_t Fragment = 0x01;
+
+        constexpr size_t PacketHeader = 18;
+        constexpr size_t RecordHeader = 8;
+        constexpr size_t FragmentHeader = 8;
+        constexpr size_t MaxFragments = 0xFFFF;
+
+        constexpr uint32_t AckBits = 64;
+        constexpr uint32_t PacketThreshold = 3;             // newer packets acked before one counts as lost
+        constexpr uint32_t TimeThreshold = 9;               // ... or eighths of the RTT since it was sent
+        constexpr uint32_t MaxAhead = 1u << 20;             // reliable ids further ahead are garbage
+        constexpr size_t MaxReads = 1024;                   // datagrams per pump()
+        constexpr double PacingGain = 1.25;
+        constexpr Clock::duration PacingSlack = std::chrono::milliseconds(1);
+        constexpr Clock::duration ReassemblyTimeout = std::chrono::seconds(2);  // unreliable partials
+
+        // Serial number arithmetic, so sequences and ids may wrap.
+        bool before(uint32_t a, uint32_t b) noexcept
+        {
+            return static_cast<int32_t>(a - b) < 0;
+        }
+
+        uint64_t key(uint8_t channel, uint32_t id) noexcept
+        {
+            return (static_cast<uint64_t>(channel) << 32) | id;
+        }
+
+        template<typename T>
+        void put(std::byte* at, T value) noexcept
+        {
+            for(size_t i = 0; i < sizeof(T); ++i) at[i] = static_cast<std::byte>(value >> (8 * (sizeof(T) - 1 - i)));
+        }
+
+        template<typename T>
+        T get(std::byte const * at) noexcept
+        {
+            T value = 0;
+            for(size_t i = 0; i < sizeof(T); ++i) value = static_cast<T>((value << 8) | static_cast<T>(at[i]));
+            return value;
+        }
+    }
+
+    struct ReliableUdpSession::State
+    {
+        struct FragmentRef
+        {
+            uint8_t channel;
+            uint32_t id;
+            uint16_t index;
+        };
+
+        struct Outgoing
+        {
+            std::vector<std::byte> data;
+            std::vector<bool> acked;        // reliable only, per fragment
+            uint16_t fragments;
+            uint16_t remaining;             // reliable: not acked, unreliable: not sent
+            bool reliable;
+        };
+
+        struct SentPacket
+        {
+            uint32_t sequence;
+            Clock::time_point sent;
+            size_t bytes;
+            bool acked;
+            std::vector<FragmentRef> fragments;   // the reliable ones
+        };
+
+        struct Partial
+        {
+            std::vector<std::byte> data;
+            std::vector<bool> received;
+            size_t missing;
+            Clock::time_point started;
+        };
+
+        struct Inbound
+        {
+            uint32_t next = 0;      // ordered: next to deliver; unordered: oldest not seen
+            std::map<uint32_t, std::vector<std::byte>> early;     // ordered, waiting for next
+            std::set<uint32_t> seen;                              // unordered, above next
+        };
+
+        UdpSocket* socket;
+        Endpoint peer;
+        Config config;
+        size_t singlePayload;       // largest unfragmented message
+        size_t fragmentPayload;
+
+        // Send side
+        std::vector<uint32_t> nextId;
+        std::unordered_map<uint64_t, Outgoing> outgoing;
+        std::deque<FragmentRef> queue;
+        std::deque<FragmentRef> resend;
+        std::deque<SentPacket> inFlight;
+        size_t queued = 0;
+        uint32_t nextSequence = 0;
+        uint32_t largestAcked = 0;
+        bool anyAcked = false;
+
+        // Congestion control and RTT
+        size_t window;
+        size_t threshold = SIZE_MAX;
+        size_t flight = 0;
+        uint32_t recoveryStart = 0;
+        Clock::duration srtt{};
+        Clock::duration rttvar{};
+        bool sampled = false;
+        unsigned backoff = 0;
+        Clock::time_point nextSend{};
+        Clock::time_point lastProgress{};   // last data sent or newly acked
+        unsigned probes = 0;
+
+        // Receive side
+        uint32_t remoteLatest = 0;
+        uint64_t remoteBits = 0;
+        bool remoteAny = false;
+        unsigned ackOwed = 0;
+        Clock::time_point ackDue{};
+        std::vector<Inbound> inbound;
+        std::unordered_map<uint64_t, Partial> partials;
+        Clock::time_point nextPurge{};
+        std::deque<Message> delivered;
+
+        std::vector<std::byte> packet;
+        std::vector<std::byte> datagram;
+        std::minstd_rand random;
+        std::uniform_real_distribution<double> uniform{0.0, 1.0};
+        Stats counters;
+
+        State(UdpSocket& socket, Endpoint peer, Config config) :
+            socket(&socket),
+            peer(peer),
+            config(std::move(config)),
+            random(this->config.seed)
+        {
+            size_t channels = this->config.channels.size();
+            if(channels == 0 || channels > 256) throw std::invalid_argument("channels must be 1..256");
+            if(this->config.mtu <= PacketHeader + RecordHeader + FragmentHeader || this->config.mtu > 65507) throw std::invalid_argument("mtu is out of range");
+
+            singlePayload = this->config.mtu - PacketHeader - RecordHeader;
+            fragmentPayload = singlePayload - FragmentHeader;
+            window = std::max<size_t>(this->config.initialWindow, 2) * this->config.mtu;
+
+            nextId.assign(channels, 0);
+            inbound.resize(channels);
+            packet.resize(this->config.mtu);
+        }
+
+        Clock::duration rto() const noexcept
+        {
+            Clock::duration base = config.initialRto;
+            if(sampled) base = srtt + std::max<Clock::duration>(4 * rttvar, std::chrono::milliseconds(1)) + config.ackDelay;
+            base = std::clamp<Clock::duration>(base, config.minRto, config.maxRto);
+            return std::min<Clock::duration>(base * (1 << std::min(backoff, 6u)), config.maxRto);
+        }
+
+        // RFC 6298. Each transmission is a new packet, so samples are never ambiguous.
+        void sample(Clock::duration rtt) noexcept
+        {
+            if(!sampled)
+            {
+                srtt = rtt;
+                rttvar = rtt / 2;
+                sampled = true;
+            }
+            else
+            {
+                Clock::duration error = srtt > rtt ? srtt - rtt : rtt - srtt;
+                rttvar = (3 * rttvar + error) / 4;
+                srtt = (7 * srtt + rtt) / 8;
+            }
+            backoff = 0;
+        }
+
+        // How long a packet may trail an acked newer one before it counts as lost.
+        Clock::duration lossDelay() const noexcept
+        {
+            Clock::duration rtt = sampled ? srtt : Clock::duration(config.initialRto);
+            return std::max<Clock::duration>(rtt * TimeThreshold / 8, std::chrono::milliseconds(1));
+        }
+
+        // Silence after which a probe asks the peer to ack: a lost ack or the loss of a
+        // burst's tail would otherwise wait for the retransmission timeout.
+        Clock::time_point probeAt() const noexcept
+        {
+            Clock::duration pto = config.initialRto;
+            if(sampled) pto = std::max<Clock::duration>(2 * srtt, std::chrono::milliseconds(1));
+            return lastProgress + pto * (1 << std::min(probes, 6u));
+        }
+
+        void congestion(uint32_t sequence) noexcept
+        {
+            // One reduction per window of data: losses of packets sent before the last
+            // reduction belong to the same event.
+            if(before(sequence, recoveryStart)) return;
+
+            threshold = std::max(window / 2, 2 * config.mtu);
+            window = threshold;
+            recoveryStart = nextSequence;
+        }
+
+        void ackFragment(FragmentRef const & ref)
+        {
+            auto it = outgoing.find(key(ref.channel, ref.id));
+            if(it == outgoing.end()) return;
+
+            Outgoing& message = it->second;
+            if(message.acked[ref.index]) return;
+            message.acked[ref.index] = true;
+            if(--message.remaining > 0) return;
+
+            queued -= message.data.size();
+            outgoing.erase(it);
+        }
+
+        void acknowledge(uint32_t ack, uint64_t bits, Clock::time_point now)
+        {
+            if(!anyAcked || before(largestAcked, ack))
+            {
+                largestAcked = ack;
+                anyAcked = true;
+            }
+
+            // The deque is in sequence order: skip to the oldest packet the ack covers.
+            uint32_t oldest = ack - AckBits;
+            auto first = std::partition_point(inFlight.begin(), inFlight.end(), [oldest](SentPacket const & sent)
+            {
+                return before(sent.sequence, oldest);
+            });
+
+            SentPacket const * newest = nullptr;
+            for(auto it = first; it != inFlight.end() && !before(ack, it->sequence); ++it)
+            {
+                uint32_t distance = ack - it->sequence;
+                bool covered = distance == 0 || ((bits >> (distance - 1)) & 1) != 0;
+                if(!covered || it->acked) continue;
+
+                it->acked = true;
+                flight -= it->bytes;
+                newest = &*it;
+
+                if(window < threshold) window += it->bytes;
+                else window += std::max<size_t>(config.mtu * it->bytes / window, 1);
+
+                for(FragmentRef const & ref : it->fragments) ackFragment(ref);
+            }
+            if(newest != nullptr)
+            {
+                sample(now - newest->sent);
+                lastProgress = now;
+                probes = 0;
+            }
+
+            while(!inFlight.empty() && inFlight.front().acked) inFlight.pop_front();
+        }
+
+        void detectLosses(Clock::time_point now)
+        {
+            Clock::duration timeout = rto();
+            Clock::duration delay = lossDelay();
+            bool expired = false;
+
+            // Packets are sent in sequence order, so only the front can be overdue.
+            while(!inFlight.empty())
+            {
+                SentPacket& sent = inFlight.front();
+                if(!sent.acked)
+                {
+                    Clock::duration age = now - sent.sent;
+                    bool overtaken = anyAcked && before(sent.sequence, largestAcked) &&
+                                     (!before(largestAcked, sent.sequence + PacketThreshold) || age >= delay);
+                    bool late = age >= timeout;
+                    if(!overtaken && !late) break;
+
+                    flight -= sent.bytes;
+                    ++counters.packetsLost;
+                    for(FragmentRef const & ref : sent.fragments)
+                    {
+                        auto it = outgoing.find(key(ref.channel, ref.id));
+                        if(it != outgoing.end() && !it->second.acked[ref.index]) resend.push_back(ref);
+                    }
+                    congestion(sent.sequence);
+                    expired = expired || (late && !overtaken);
+                }
+                inFlight.pop_front();
+            }
+
+            if(expired) ++backoff;
+        }
+
+        void writeHeader(uint32_t sequence, uint8_t flags) noexcept
+        {
+            std::byte* at = packet.data();
+            put<uint8_t>(at, Magic);
+            put<uint8_t>(at + 1, static_cast<uint8_t>(flags | (remoteAny ? HasAck : 0)));
+            put<uint32_t>(at + 2, sequence);
+            put<uint32_t>(at + 6, remoteLatest);
+            put<uint64_t>(at + 10, remoteBits);
+            ackOwed = 0;
+        }
+
+        void output(size_t size)
+        {
+            ++counters.packetsSent;
+            if(config.simulatedLoss > 0.0 && uniform(random) < config.simulatedLoss)
+            {
+                ++counters.simulatedDrops;
+                return;
+            }
+
+            // WouldBlock and errors are left to loss detection, as if the network dropped it.
+            socket->sendTo(peer, packet.data(), size);
+        }
+
+        void sendAck()
+        {
+            writeHeader(nextSequence++, 0);
+            output(PacketHeader);
+        }
+
+        // Appends queued fragments to the packet while they fit; false once it is full.
+        bool take(std::deque<FragmentRef>& from, size_t& used, SentPacket& sent, bool again)
+        {
+            while(!from.empty())
+            {
+                FragmentRef ref = from.front();
+                auto it = outgoing.find(key(ref.channel, ref.id));
+                if(it == outgoing.end() || (it->second.reliable && it->second.acked[ref.index]))
+                {
+                    from.pop_front();
+                    continue;
+                }
+
+                Outgoing& message = it->second;
+                bool fragmented = message.fragments > 1;
+                size_t offset = static_cast<size_t>(ref.index) * fragmentPayload;
+                size_t length = fragmented ? std::min(fragmentPayload, message.data.size() - offset) : message.data.size();
+                size_t record = RecordHeader + (fragmented ? FragmentHeader : 0) + length;
+                if(used + record > config.mtu) return false;
+
+                std::byte* at = packet.data() + used;
+                put<uint8_t>(at, ref.channel);
+                put<uint8_t>(at + 1, fragmented ? Fragment : 0);
+                put<uint16_t>(at + 2, static_cast<uint16_t>(length));
+                put<uint32_t>(at + 4, ref.id);
+                at += RecordHeader;
+                if(fragmented)
+                {
+                    put<uint16_t>(at, ref.index);
+                    put<uint16_t>(at + 2, message.fragments);
+                    put<uint32_t>(at + 4, static_cast<uint32_t>(message.data.size()));
+                    at += FragmentHeader;
+                }
+                if(length > 0) std::memcpy(at, message.data.data() + offset, length);
+                used += record;
+                from.pop_front();
+
+                if(again) ++counters.retransmits;
+                if(message.reliable)
+                {
+                    sent.fragments.push_back(ref);
+                }
+                else if(--message.remaining == 0)
+                {
+                    queued -= message.data.size();
+                    outgoing.erase(it);
+                }
+            }
+            return true;
+        }
+
+        // Sends one packet of queued fragments; false when nothing was left to send.
+        bool transmit(Clock::time_point now)
+        {
+            size_t used = PacketHeader;
+            SentPacket sent{0, now, 0, false, {}};
+            if(take(resend, used, sent, true)) take(queue, used, sent, false);
+            if(used == PacketHeader) return false;
+
+            // The last packet of a burst is acked at once, so the window reopens without
+            // waiting out the peer's ack delay.
+            bool last = (resend.empty() && queue.empty()) || flight + used + config.mtu > window;
+
+            sent.sequence = nextSequence++;
+            sent.bytes = used;
+            writeHeader(sent.sequence, last ? AckNow : 0);
+            flight += used;
+            lastProgress = now;
+            inFlight.push_back(std::move(sent));
+
+            if(sampled)
+            {
+                double seconds = std::chrono::duration<double>(srtt).count() * static_cast<double>(used) / (PacingGain * static_cast<double>(window));
+                nextSend = std::max(nextSend, now) + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+            }
+
+            output(used);
+            return true;
+        }
+
+        bool sendable(Clock::time_point now) const noexcept
+        {
+            if(flight > 0 && flight + config.mtu > window) return false;
+            return nextSend <= now + PacingSlack;
+        }
+
+        void update(Clock::time_point now)
+        {
+            detectLosses(now);
+
+            while((!resend.empty() || !queue.empty()) && sendable(now))
+            {
+                if(!transmit(now)) break;
+            }
+
+            if(ackOwed >= 2 || (ackOwed > 0 && now >= ackDue)) sendAck();
+
+            if(!inFlight.empty() && now >= probeAt())
+            {
+                writeHeader(nextSequence++, AckNow);
+                output(PacketHeader);
+                ++counters.probes;
+                ++probes;
+            }
+
+            if(!partials.empty() && now >= nextPurge)
+            {
+                std::erase_if(partials, [&](auto const & entry)
+                {
+                    uint8_t channel = static_cast<uint8_t>(entry.first >> 32);
+                    return config.channels[channel] == Delivery::Unreliable && now - entry.second.started >= ReassemblyTimeout;
+                });
+                nextPurge = now + ReassemblyTimeout / 4;
+            }
+        }
+
+        void deliver(uint8_t channel, std::vector<std::byte> data)
+        {
+            delivered.push_back(Message{channel, std::move(data)});
+            ++counters.messagesDelivered;
+        }
+
+        bool duplicate(uint8_t channel, uint32_t id) const
+        {
+            Delivery mode = config.channels[channel];
+            if(mode == Delivery::Unreliable) return false;
+
+            Inbound const & in = inbound[channel];
+            if(before(id, in.next) || id - in.next >= MaxAhead) return true;
+            if(mode == Delivery::ReliableOrdered) return in.early.count(id) > 0;
+            return in.seen.count(id) > 0;
+        }
+
+        void accept(uint8_t channel, uint32_t id, std::vector<std::byte> data)
+        {
+            Inbound& in = inbound[channel];
+            switch(config.channels[channel])
+            {
+            case Delivery::ReliableOrdered:
+                if(id != in.next)
+                {
+                    in.early.emplace(id, std::move(data));
+                    return;
+                }
+                deliver(channel, std::move(data));
+                ++in.next;
+                for(auto it = in.early.find(in.next); it != in.early.end(); it = in.early.find(in.next))
+                {
+                    deliver(channel, std::move(it->second));
+                    in.early.erase(it);
+                    ++in.next;
+                }
+                return;
+            case Delivery::ReliableUnordered:
+                deliver(channel, std::move(data));
+                if(id != in.next)
+                {
+                    in.seen.insert(id);
+                    return;
+                }
+                ++in.next;
+                while(in.seen.erase(in.next) > 0) ++in.next;
+                return;
+            default:
+                deliver(channel, std::move(data));
+                return;
+            }
+        }
+
+        void record(uint8_t channel, uint32_t id, std::byte const * payload, size_t length, uint16_t index, uint16_t count, uint32_t total, Clock::time_point now)
+        {
+            if(duplicate(channel, id)) return;
+            if(count <= 1)
+            {
+                accept(channel, id, std::vector<std::byte>(payload, payload + length));
+                return;
+            }
+
+            // Every fragment but the last is full size, which places it without an offset field.
+            if(index >= count || total > config.maxMessage) return;
+            size_t offset = index + 1 == count ? total - std::min<size_t>(length, total) : static_cast<size_t>(index) * length;
+            if(offset + length > total) return;
+
+            auto [it, created] = partials.try_emplace(key(channel, id));
+            Partial& partial = it->second;
+            if(created)
+            {
+                partial.data.resize(total);
+                partial.received.assign(count, false);
+                partial.missing = count;
+                partial.started = now;
+            }
+            if(partial.received.size() != count || partial.data.size() != total || partial.received[index]) return;
+
+            if(length > 0) std::memcpy(partial.data.data() + offset, payload, length);
+            partial.received[index] = true;
+            if(--partial.missing > 0) return;
+
+            std::vector<std::byte> data = std::move(partial.data);
+            partials.erase(it);
+            accept(channel, id, std::move(data));
+        }
+
+        void input(std::byte const * data, size_t size, Clock::time_point now)
+        {
+            if(size < PacketHeader || get<uint8_t>(data) != Magic) return;
+
+            uint8_t flags = get<uint8_t>(data + 1);
+            uint32_t sequence = get<uint32_t>(data + 2);
+            ++counters.packetsReceived;
+
+            if(!remoteAny || before(remoteLatest, sequence))
+            {
+                uint32_t shift = remoteAny ? sequence - remoteLatest : AckBits + 1;
+                if(shift > AckBits) remoteBits = 0;
+                else if(shift == AckBits) remoteBits = 1ull << (AckBits - 1);
+                else remoteBits = (remoteBits << shift) | (1ull << (shift - 1));
+                remoteLatest = sequence;
+                remoteAny = true;
+            }
+            else if(sequence != remoteLatest)
+            {
+                uint32_t distance = remoteLatest - sequence;
+                if(distance <= AckBits) remoteBits |= 1ull << (distance - 1);
+            }
+
+            if(flags & HasAck) acknowledge(get<uint32_t>(data + 6), get<uint64_t>(data + 10), now);
+
+            bool carried = false;
+            size_t pos = PacketHeader;
+            while(pos + RecordHeader <= size)
+            {
+                uint8_t channel = get<uint8_t>(data + pos);
+                bool fragmented = (get<uint8_t>(data + pos + 1) & Fragment) != 0;
+                size_t length = get<uint16_t>(data + pos + 2);
+                uint32_t id = get<uint32_t>(data + pos + 4);
+                pos += RecordHeader;
+
+                uint16_t index = 0;
+                uint16_t count = 1;
+                uint32_t total = 0;
+                if(fragmented)
+                {
+                    if(pos + FragmentHeader > size) return;
+                    index = get<uint16_t>(data + pos);
+                    count = get<uint16_t>(data + pos + 2);
+                    total = get<uint32_t>(data + pos + 4);
+                    pos += FragmentHeader;
+                }
+                if(pos + length > size || channel >= config.channels.size()) return;
+
+                carried = true;
+                record(channel, id, data + pos, length, index, count, total, now);
+                pos += length;
+            }
+
+            // Pure acks are not acked, or two idle peers would ack each other forever.
+            if(carried && ackOwed++ == 0) ackDue = now + config.ackDelay;
+
+            // A burst longer than the bitfield would push unreported packets out of it.
+            if((flags & AckNow) || ackOwed >= AckBits / 2) sendAck();
+        }
+    };
+
+    ReliableUdpSession::ReliableUdpSession(UdpSocket& socket, Endpoint peer) : ReliableUdpSession(socket, peer, Config{})
+    {
+    }
+
+    ReliableUdpSession::ReliableUdpSession(UdpSocket& socket, Endpoint peer, Config config) :
+        state(std::make_unique<State>(socket, peer, std::move(config)))
+    {
+    }
+
+    ReliableUdpSession::~ReliableUdpSession() noexcept = default;
+
+    ReliableUdpSession::ReliableUdpSession(ReliableUdpSession&& other) noexcept = default;
+    ReliableUdpSession& ReliableUdpSession::operator=(ReliableUdpSession&& other) noexcept = default;
+
+    Result ReliableUdpSession::send(uint8_t channel, void const * data, size_t size)
+    {
+        State& s = *state;
+        if(channel >= s.config.channels.size() || size > s.config.maxMessage) return {ResultType::Error, 0};
+
+        uint16_t fragments = 1;
+        if(size > s.singlePayload)
+        {
+            size_t count = (size + s.fragmentPayload - 1) / s.fragmentPayload;
+            if(count > MaxFragments) return {ResultType::Error, 0};
+            fragments = static_cast<uint16_t>(count);
+        }
+        if(s.queued > 0 && s.queued + size > s.config.maxQueued) return {ResultType::WouldBlock, 0};
+
+        bool reliable = s.config.channels[channel] != Delivery::Unreliable;
+        std::byte const * bytes = static_cast<std::byte const *>(data);
+
+        uint32_t id = s.nextId[channel]++;
+        State::Outgoing& message = s.outgoing[key(channel, id)];
+        message.data.assign(bytes, bytes + size);
+        message.acked.assign(reliable ? fragments : 0, false);
+        message.fragments = fragments;
+        message.remaining = fragments;
+        message.reliable = reliable;
+
+        s.queued += size;
+        for(uint16_t i = 0; i < fragments; ++i) s.queue.push_back({channel, id, i});
+
+        return {ResultType::Data, size};
+    }
+
+    bool ReliableUdpSession::receive(Message& message)
+    {
+        State& s = *state;
+        if(s.delivered.empty()) return false;
+
+        message = std::move(s.delivered.front());
+        s.delivered.pop_front();
+        return true;
+    }
+
+    void ReliableUdpSession::input(void const * data, size_t size, Clock::time_point now)
+    {
+        state->input(static_cast<std::byte const *>(data), size, now);
+    }
+
+    void ReliableUdpSession::update(Clock::time_point now)
+    {
+        state->update(now);
+    }
+
+    size_t ReliableUdpSession::pump(Clock::time_point now)
+    {
+        State& s = *state;
+        if(s.datagram.empty()) s.datagram.resize(64 * 1024);
+
+        size_t reads = 0;
+        while(reads < MaxReads)
+        {
+            Endpoint from;
+            Result res = s.socket->recvFrom(from, s.datagram.data(), s.datagram.size());
+            if(res.type != ResultType::Data) break;
+
+            ++reads;
+            if(from == s.peer) s.input(s.datagram.data(), res.bytes, now);
+        }
+
+        s.update(now);
+        return reads;
+    }
+
+    int ReliableUdpSession::timeout(Clock::time_point now) const noexcept
+    {
+        State const & s = *state;
+        if(s.ackOwed >= 2) return 0;
+
+        bool any = false;
+        Clock::time_point next = Clock::time_point::max();
+        auto consider = [&](Clock::time_point at)
+        {
+            next = std::min(next, at);
+            any = true;
+        };
+
+        if(s.ackOwed > 0) consider(s.ackDue);
+        if((!s.resend.empty() || !s.queue.empty()) && (s.flight == 0 || s.flight + s.config.mtu <= s.window)) consider(s.nextSend - PacingSlack);
+        if(!s.inFlight.empty())
+        {
+            State::SentPacket const & oldest = s.inFlight.front();
+            bool overtaken = s.anyAcked && before(oldest.sequence, s.largestAcked);
+            consider(oldest.sent + (overtaken ? s.lossDelay() : s.rto()));
+            consider(s.probeAt());
+        }
+        if(!any) return -1;
+        if(next <= now) return 0;
+
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(next - now).count();
+        return static_cast<int>(std::min<decltype(wait)>(wait, INT_MAX));
+    }
+
+    size_t ReliableUdpSession::pending() const noexcept
+    {
+        return state->queued;
+    }
+
+    ReliableUdpSession::Stats ReliableUdpSession::stats() const noexcept
+    {
+        State const & s = *state;
+        Stats stats = s.counters;
+        stats.srtt = std::chrono::duration_cast<std::chrono::microseconds>(s.srtt);
+        stats.rttvar = std::chrono::duration_cast<std::chrono::microseconds>(s.rttvar);
+        stats.rto = std::chrono::duration_cast<std::chrono::microseconds>(s.rto());
+        stats.window = s.window;
+        stats.inFlight = s.flight;
+        return stats;
+    }
+
+    Endpoint const & ReliableUdpSession::peer() const noexcept
+    {
+        return state->peer;
+    }
+}
\ No newline at end of file
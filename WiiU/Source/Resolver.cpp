@@ -0,0 +1,245 @@
+#include "Network/Resolver.hpp"
+#include "Network/Platform.hpp"
+#include "Network/SocketAddress.hpp"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+namespace Library::Network
+{
+    Resolver::Resolver() : Resolver(Config{})
+    {
+    }
+
+    Resolver::Resolver(Config config) :
+        config(std::move(config)),
+        stopping(false)
+    {
+        if(!this->config.lookup) this->config.lookup = systemLookup();
+        if(this->config.workers == 0) this->config.workers = 1;
+        if(this->config.maxEntries == 0) this->config.maxEntries = 1;
+
+        for(size_t i = 0; i < this->config.workers; ++i)
+        {
+            workers.emplace_back([this]
+            {
+                work();
+            });
+        }
+    }
+
+    Resolver::~Resolver() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+
+        for(std::thread& worker : workers) worker.join();
+    }
+
+    bool Resolver::tryResolve(std::string_view host, uint16_t port, Endpoint& endpoint)
+    {
+        if(std::optional<Endpoint> numeric = Endpoint::parse(host, port))
+        {
+            endpoint = *numeric;
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = cache.find(host);
+        if(it == cache.end() || it->second.addresses.empty()) return false;
+        if(it->second.expires <= Clock::now()) return false;
+
+        endpoint = it->second.addresses.front().withPort(port);
+        return true;
+    }
+
+    void Resolver::resolve(std::string host, uint16_t port, Callback callback, EventLoop* loop)
+    {
+        Waiter waiter{port, std::move(callback), loop};
+
+        if(std::optional<Endpoint> numeric = Endpoint::parse(host, port))
+        {
+            complete(waiter, {*numeric});
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        auto it = cache.find(host);
+        if(it != cache.end() && it->second.expires > Clock::now())
+        {
+            std::vector<Endpoint> endpoints = withPort(it->second.addresses, port);
+            lock.unlock();
+            complete(waiter, std::move(endpoints));
+            return;
+        }
+
+        auto [pending, fresh] = inflight.try_emplace(host);
+        pending->second.push_back(std::move(waiter));
+        if(!fresh) return;
+
+        queue.push_back(std::move(host));
+        lock.unlock();
+        wakeup.notify_one();
+    }
+
+    std::vector<Endpoint> Resolver::resolveNow(std::string const & host, uint16_t port)
+    {
+        if(std::optional<Endpoint> numeric = Endpoint::parse(host, port)) return {*numeric};
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(host);
+            if(it != cache.end() && it->second.expires > Clock::now()) return withPort(it->second.addresses, port);
+        }
+
+        std::vector<Endpoint> addresses = config.lookup(host);
+        store(host, addresses);
+        return withPort(addresses, port);
+    }
+
+    void Resolver::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.clear();
+    }
+
+    Resolver::Lookup Resolver::systemLookup()
+    {
+        return [](std::string const & host)
+        {
+            std::vector<Endpoint> addresses;
+
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+
+            addrinfo* info = nullptr;
+            int res = ::getaddrinfo(host.c_str(), nullptr, &hints, &info);
+            if(res != 0) return addresses;
+
+            for(addrinfo* it = info; it != nullptr; it = it->ai_next)
+            {
+                Endpoint endpoint = fromSocketAddress(it->ai_addr, static_cast<Platform::Length>(it->ai_addrlen));
+                if(endpoint.family() != AddressFamily::None) addresses.push_back(endpoint);
+            }
+
+            ::freeaddrinfo(info);
+            return addresses;
+        };
+    }
+
+    Resolver::Lookup Resolver::hostsFileLookup(std::string const & path)
+    {
+        auto table = std::make_shared<std::unordered_map<std::string, std::vector<Endpoint>>>();
+
+        std::ifstream file(path);
+        std::string line;
+        while(std::getline(file, line))
+        {
+            size_t comment = line.find('#');
+            if(comment != std::string::npos) line.resize(comment);
+
+            std::istringstream fields(line);
+            std::string address;
+            if(!(fields >> address)) continue;
+
+            std::optional<Endpoint> endpoint = Endpoint::parse(address, 0);
+            if(!endpoint) continue;
+
+            std::string name;
+            while(fields >> name) (*table)[name].push_back(*endpoint);
+        }
+
+        return [table](std::string const & host)
+        {
+            auto it = table->find(host);
+            if(it == table->end()) return std::vector<Endpoint>();
+            return it->second;
+        };
+    }
+
+    void Resolver::work()
+    {
+        while(true)
+        {
+            std::string host;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeup.wait(lock, [this]
+                {
+                    return stopping || !queue.empty();
+                });
+                if(stopping) return;
+
+                host = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            std::vector<Endpoint> addresses = config.lookup(host);
+            store(host, addresses);
+
+            std::vector<Waiter> waiters;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = inflight.find(host);
+                if(it != inflight.end())
+                {
+                    waiters = std::move(it->second);
+                    inflight.erase(it);
+                }
+            }
+
+            for(Waiter& waiter : waiters) complete(waiter, withPort(addresses, waiter.port));
+        }
+    }
+
+    void Resolver::store(std::string const & host, std::vector<Endpoint> const & addresses)
+    {
+        Clock::time_point now = Clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(cache.size() >= config.maxEntries && cache.find(host) == cache.end())
+        {
+            std::erase_if(cache, [now](auto const & item)
+            {
+                return item.second.expires <= now;
+            });
+            if(cache.size() >= config.maxEntries) cache.erase(cache.begin());
+        }
+
+        Entry& entry = cache[host];
+        entry.addresses = addresses;
+        entry.expires = now + (addresses.empty() ? config.negativeTtl : config.ttl);
+    }
+
+    std::vector<Endpoint> Resolver::withPort(std::vector<Endpoint> const & addresses, uint16_t port)
+    {
+        std::vector<Endpoint> endpoints;
+        endpoints.reserve(addresses.size());
+        for(Endpoint const & address : addresses) endpoints.push_back(address.withPort(port));
+        return endpoints;
+    }
+
+    void Resolver::complete(Waiter& waiter, std::vector<Endpoint> endpoints)
+    {
+        if(!waiter.callback) return;
+
+        if(waiter.loop == nullptr)
+        {
+            waiter.callback(endpoints);
+            return;
+        }
+
+        waiter.loop->post([callback = std::move(waiter.callback), endpoints = std::move(endpoints)]
+        {
+            callback(endpoints);
+        });
+    }
+}
\ No newline at end of file
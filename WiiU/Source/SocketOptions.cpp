@@ -0,0 +1,232 @@
+#include "Network/SocketOptions.hpp"
+#include "Network/Platform.hpp"
+
+#include <algorithm>
+
+namespace Library::Network
+{
+    namespace
+    {
+        bool unsupported() noexcept
+        {
+            Platform::setLastError(Platform::OptionUnsupported);
+            return false;
+        }
+
+        bool setFlag(SocketFD fd, int level, int name, bool enable) noexcept
+        {
+            int v = enable ? 1 : 0;
+            return Platform::setOption(fd, level, name, v);
+        }
+
+        std::optional<int> getInt(SocketFD fd, int level, int name) noexcept
+        {
+            int v = 0;
+            if(!Platform::getOption(fd, level, name, v)) return std::nullopt;
+            return v;
+        }
+
+        std::optional<bool> getFlag(SocketFD fd, int level, int name) noexcept
+        {
+            std::optional<int> v = getInt(fd, level, name);
+            if(!v) return std::nullopt;
+            return *v != 0;
+        }
+
+        bool applyKeepalive(SocketFD fd, SocketOptions::Keepalive const & keepalive) noexcept
+        {
+            if(!setFlag(fd, SOL_SOCKET, SO_KEEPALIVE, keepalive.enabled)) return false;
+            if(!keepalive.enabled) return true;
+
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+            if(keepalive.idleSeconds > 0 && !Platform::setOption(fd, IPPROTO_TCP, TCP_KEEPIDLE, keepalive.idleSeconds)) return false;
+            if(keepalive.intervalSeconds > 0 && !Platform::setOption(fd, IPPROTO_TCP, TCP_KEEPINTVL, keepalive.intervalSeconds)) return false;
+            if(keepalive.probes > 0 && !Platform::setOption(fd, IPPROTO_TCP, TCP_KEEPCNT, keepalive.probes)) return false;
+            return true;
+#else
+            if(keepalive.idleSeconds > 0 || keepalive.intervalSeconds > 0 || keepalive.probes > 0) return unsupported();
+            return true;
+#endif
+        }
+
+        bool set(SocketFD fd, SocketOptions const & options) noexcept
+        {
+            if(options.receiveBuffer && !Platform::setOption(fd, SOL_SOCKET, SO_RCVBUF, *options.receiveBuffer)) return false;
+            if(options.sendBuffer && !Platform::setOption(fd, SOL_SOCKET, SO_SNDBUF, *options.sendBuffer)) return false;
+            if(options.noDelay && !setFlag(fd, IPPROTO_TCP, TCP_NODELAY, *options.noDelay)) return false;
+
+            if(options.quickAck)
+            {
+#if defined(TCP_QUICKACK)
+                if(!setFlag(fd, IPPROTO_TCP, TCP_QUICKACK, *options.quickAck)) return false;
+#else
+                return unsupported();
+#endif
+            }
+
+            if(options.notSentLowWatermark)
+            {
+#if defined(TCP_NOTSENT_LOWAT)
+                if(!Platform::setOption(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, *options.notSentLowWatermark)) return false;
+#else
+                return unsupported();
+#endif
+            }
+
+            if(options.busyPollUs)
+            {
+#if defined(SO_BUSY_POLL)
+                if(!Platform::setOption(fd, SOL_SOCKET, SO_BUSY_POLL, *options.busyPollUs)) return false;
+#else
+                return unsupported();
+#endif
+            }
+
+            if(options.keepalive && !applyKeepalive(fd, *options.keepalive)) return false;
+
+            if(options.lingerSeconds)
+            {
+                linger value{};
+                value.l_onoff = *options.lingerSeconds >= 0 ? 1 : 0;
+                value.l_linger = static_cast<decltype(value.l_linger)>(std::max(*options.lingerSeconds, 0));
+                if(!Platform::setOption(fd, SOL_SOCKET, SO_LINGER, value)) return false;
+            }
+
+            if(options.priority)
+            {
+#if defined(SO_PRIORITY)
+                if(!Platform::setOption(fd, SOL_SOCKET, SO_PRIORITY, *options.priority)) return false;
+#else
+                return unsupported();
+#endif
+            }
+
+            if(options.incomingCpu)
+            {
+#if defined(SO_INCOMING_CPU)
+                if(!Platform::setOption(fd, SOL_SOCKET, SO_INCOMING_CPU, *options.incomingCpu)) return false;
+#else
+                return unsupported();
+#endif
+            }
+
+            return true;
+        }
+
+        // Reads the fields wanted sets, whatever their values; the rest stay unset, as
+        // do those the socket doesn't report.
+        SocketOptions read(SocketFD fd, SocketOptions const & wanted) noexcept
+        {
+            SocketOptions options;
+            if(wanted.receiveBuffer) options.receiveBuffer = getInt(fd, SOL_SOCKET, SO_RCVBUF);
+            if(wanted.sendBuffer) options.sendBuffer = getInt(fd, SOL_SOCKET, SO_SNDBUF);
+            if(wanted.noDelay) options.noDelay = getFlag(fd, IPPROTO_TCP, TCP_NODELAY);
+#if defined(TCP_QUICKACK)
+            if(wanted.quickAck) options.quickAck = getFlag(fd, IPPROTO_TCP, TCP_QUICKACK);
+#endif
+#if defined(TCP_NOTSENT_LOWAT)
+            if(wanted.notSentLowWatermark) options.notSentLowWatermark = getInt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT);
+#endif
+#if defined(SO_BUSY_POLL)
+            if(wanted.busyPollUs) options.busyPollUs = getInt(fd, SOL_SOCKET, SO_BUSY_POLL);
+#endif
+
+            std::optional<bool> enabled;
+            if(wanted.keepalive) enabled = getFlag(fd, SOL_SOCKET, SO_KEEPALIVE);
+            if(enabled)
+            {
+                SocketOptions::Keepalive keepalive;
+                keepalive.enabled = *enabled;
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+                keepalive.idleSeconds = getInt(fd, IPPROTO_TCP, TCP_KEEPIDLE).value_or(0);
+                keepalive.intervalSeconds = getInt(fd, IPPROTO_TCP, TCP_KEEPINTVL).value_or(0);
+                keepalive.probes = getInt(fd, IPPROTO_TCP, TCP_KEEPCNT).value_or(0);
+#endif
+                options.keepalive = keepalive;
+            }
+
+            linger value{};
+            if(wanted.lingerSeconds && Platform::getOption(fd, SOL_SOCKET, SO_LINGER, value)) options.lingerSeconds = value.l_onoff ? static_cast<int>(value.l_linger) : -1;
+
+#if defined(SO_PRIORITY)
+            if(wanted.priority) options.priority = getInt(fd, SOL_SOCKET, SO_PRIORITY);
+#endif
+#if defined(SO_INCOMING_CPU)
+            if(wanted.incomingCpu) options.incomingCpu = getInt(fd, SOL_SOCKET, SO_INCOMING_CPU);
+#endif
+            return options;
+        }
+
+        // Every requested option must be one the socket reports, so unsupported ones
+        // (missing on the platform, or a TCP option on a UDP socket) fail before
+        // anything is set.
+        bool supported(SocketFD fd, SocketOptions const & wanted, SocketOptions const & current) noexcept
+        {
+            if(wanted.receiveBuffer && !current.receiveBuffer) return false;
+            if(wanted.sendBuffer && !current.sendBuffer) return false;
+            if(wanted.noDelay && !current.noDelay) return false;
+            if(wanted.quickAck && !current.quickAck) return false;
+            if(wanted.notSentLowWatermark && !current.notSentLowWatermark) return false;
+            if(wanted.busyPollUs && !current.busyPollUs) return false;
+            if(wanted.lingerSeconds && !current.lingerSeconds) return false;
+            if(wanted.priority && !current.priority) return false;
+            if(wanted.incomingCpu && !current.incomingCpu) return false;
+
+            if(wanted.keepalive)
+            {
+                if(!current.keepalive) return false;
+
+                SocketOptions::Keepalive const & keepalive = *wanted.keepalive;
+                bool timed = keepalive.enabled && (keepalive.idleSeconds > 0 || keepalive.intervalSeconds > 0 || keepalive.probes > 0);
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+                if(timed && !getInt(fd, IPPROTO_TCP, TCP_KEEPIDLE)) return false;
+#else
+                (void)fd;
+                if(timed) return false;
+#endif
+            }
+            return true;
+        }
+
+        // current as read before apply, made fit to be set back.
+        SocketOptions restorable(SocketOptions current) noexcept
+        {
+#if defined(__linux__)
+            // Linux reports buffer sizes doubled; setting that back would double them again.
+            if(current.receiveBuffer) *current.receiveBuffer /= 2;
+            if(current.sendBuffer) *current.sendBuffer /= 2;
+#endif
+            return current;
+        }
+    }
+
+    bool SocketOptions::apply(SocketFD fd) const noexcept
+    {
+        SocketOptions current = read(fd, *this);
+        if(!supported(fd, *this, current)) return unsupported();
+
+        if(set(fd, *this)) return true;
+
+        // E.g. EPERM or EINVAL for one value: put back what was set before it.
+        int error = Platform::lastError();
+        set(fd, restorable(current));
+        Platform::setLastError(error);
+        return false;
+    }
+
+    SocketOptions SocketOptions::query(SocketFD fd) noexcept
+    {
+        SocketOptions all;
+        all.receiveBuffer = 0;
+        all.sendBuffer = 0;
+        all.noDelay = false;
+        all.quickAck = false;
+        all.notSentLowWatermark = 0;
+        all.busyPollUs = 0;
+        all.keepalive = Keepalive{};
+        all.lingerSeconds = 0;
+        all.priority = 0;
+        all.incomingCpu = 0;
+        return read(fd, all);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "Network/Statistics.hpp"
+#include "Network/Probe.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+
+namespace Library::Network
+{
+    namespace Detail
+    {
+        std::atomic<bool> statisticsEnabled{false};
+    }
+
+    namespace
+    {
+        // One slot per error code below ErrorCodes; the extra last slot counts the rest
+        // (all of Winsock's), reported as StatisticsSnapshot::OtherErrors.
+        constexpr size_t ErrorCodes = 160;
+        constexpr size_t ErrorSlots = ErrorCodes + 1;
+
+        size_t errorSlot(int error) noexcept
+        {
+            return error >= 0 && static_cast<size_t>(error) < ErrorCodes ? static_cast<size_t>(error) : ErrorCodes;
+        }
+
+        struct MetricCells
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> wouldBlock{0};
+            std::atomic<uint64_t> disconnects{0};
+            std::atomic<uint64_t> errors{0};
+            std::atomic<uint64_t> latency[LatencyHistogram::Buckets]{};
+        };
+
+        struct ThreadStatistics
+        {
+            ThreadStatistics() noexcept;
+            ~ThreadStatistics() noexcept;
+
+            MetricCells metrics[MetricCount];
+            std::atomic<uint64_t> errors[ErrorSlots]{};
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<ThreadStatistics*> threads;
+
+            // Totals of threads that have exited.
+            std::array<Counters, MetricCount> retired;
+            std::array<uint64_t, ErrorSlots> retiredErrors{};
+        };
+
+        Registry& registry() noexcept
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        // Only the owning thread writes its cells, so a plain load/store pair is enough;
+        // the atomics just keep concurrent snapshots well-defined.
+        void bump(std::atomic<uint64_t>& cell, uint64_t n) noexcept
+        {
+            cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        void add(Counters& total, MetricCells const & cells) noexcept
+        {
+            total.calls += cells.calls.load(std::memory_order_relaxed);
+            total.bytes += cells.bytes.load(std::memory_order_relaxed);
+            total.wouldBlock += cells.wouldBlock.load(std::memory_order_relaxed);
+            total.disconnects += cells.disconnects.load(std::memory_order_relaxed);
+            total.errors += cells.errors.load(std::memory_order_relaxed);
+            for(size_t i = 0; i < LatencyHistogram::Buckets; ++i) total.latency.counts[i] += cells.latency[i].load(std::memory_order_relaxed);
+        }
+
+        void clear(MetricCells& cells) noexcept
+        {
+            cells.calls.store(0, std::memory_order_relaxed);
+            cells.bytes.store(0, std::memory_order_relaxed);
+            cells.wouldBlock.store(0, std::memory_order_relaxed);
+            cells.disconnects.store(0, std::memory_order_relaxed);
+            cells.errors.store(0, std::memory_order_relaxed);
+            for(std::atomic<uint64_t>& bucket : cells.latency) bucket.store(0, std::memory_order_relaxed);
+        }
+
+        ThreadStatistics::ThreadStatistics() noexcept
+        {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            try
+            {
+                shared.threads.push_back(this);
+            }
+            catch(...)
+            {
+                // Still counted, just invisible to snapshots.
+            }
+        }
+
+        ThreadStatistics::~ThreadStatistics() noexcept
+        {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            for(size_t i = 0; i < MetricCount; ++i) add(shared.retired[i], metrics[i]);
+            for(size_t i = 0; i < ErrorSlots; ++i) shared.retiredErrors[i] += errors[i].load(std::memory_order_relaxed);
+
+            std::erase(shared.threads, this);
+        }
+
+        ThreadStatistics& local() noexcept
+        {
+            thread_local ThreadStatistics statistics;
+            return statistics;
+        }
+
+        bool disconnected(Metric metric, int64_t res, int error) noexcept
+        {
+            if(res == 0) return metric == Metric::TcpRecv;
+            return res < 0 && Platform::connectionLost(error);
+        }
+    }
+
+    namespace Detail
+    {
+        void record(Metric metric, int64_t res, size_t bytes, int error, std::chrono::nanoseconds elapsed) noexcept
+        {
+            ThreadStatistics& statistics = local();
+            MetricCells& cells = statistics.metrics[static_cast<size_t>(metric)];
+
+            bump(cells.calls, 1);
+            bump(cells.bytes, bytes);
+
+            if(disconnected(metric, res, error))
+            {
+                bump(cells.disconnects, 1);
+            }
+            else if(res < 0)
+            {
+                if(Platform::wouldBlock(error) || Platform::connectPending(error))
+                {
+                    bump(cells.wouldBlock, 1);
+                }
+                else
+                {
+                    bump(cells.errors, 1);
+                    bump(statistics.errors[errorSlot(error)], 1);
+                }
+            }
+
+            uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+            size_t bucket = ns == 0 ? 0 : static_cast<size_t>(std::bit_width(ns)) - 1;
+            bump(cells.latency[std::min(bucket, LatencyHistogram::Buckets - 1)], 1);
+        }
+    }
+
+    uint64_t LatencyHistogram::total() const noexcept
+    {
+        uint64_t sum = 0;
+        for(uint64_t count : counts) sum += count;
+        return sum;
+    }
+
+    uint64_t LatencyHistogram::percentile(double q) const noexcept
+    {
+        uint64_t sum = total();
+        if(sum == 0) return 0;
+
+        double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(sum);
+        uint64_t seen = 0;
+        for(size_t i = 0; i < Buckets; ++i)
+        {
+            seen += counts[i];
+            if(seen > 0 && static_cast<double>(seen) >= target) return uint64_t(1) << (i + 1);
+        }
+        return uint64_t(1) << Buckets;
+    }
+
+    void Statistics::enable(bool on) noexcept
+    {
+        Detail::statisticsEnabled.store(on, std::memory_order_relaxed);
+    }
+
+    bool Statistics::enabled() noexcept
+    {
+        return Detail::statisticsEnabled.load(std::memory_order_relaxed);
+    }
+
+    StatisticsSnapshot Statistics::snapshot()
+    {
+        StatisticsSnapshot snapshot;
+        std::array<uint64_t, ErrorSlots> errors;
+
+        {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            snapshot.metrics = shared.retired;
+            errors = shared.retiredErrors;
+
+            for(ThreadStatistics const * thread : shared.threads)
+            {
+                for(size_t i = 0; i < MetricCount; ++i) add(snapshot.metrics[i], thread->metrics[i]);
+                for(size_t i = 0; i < ErrorSlots; ++i) errors[i] += thread->errors[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        if(errors[ErrorCodes] != 0) snapshot.errors.emplace_back(StatisticsSnapshot::OtherErrors, errors[ErrorCodes]);
+        for(size_t i = 0; i < ErrorCodes; ++i)
+        {
+            if(errors[i] != 0) snapshot.errors.emplace_back(static_cast<int>(i), errors[i]);
+        }
+        return snapshot;
+    }
+
+    void Statistics::reset() noexcept
+    {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        shared.retired = {};
+        shared.retiredErrors = {};
+
+        // Racing with an owner's increment can lose the reset of that one cell.
+        for(ThreadStatistics* thread : shared.threads)
+        {
+            for(MetricCells& cells : thread->metrics) clear(cells);
+            for(std::atomic<uint64_t>& error : thread->errors) error.store(0, std::memory_order_relaxed);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "Network/TcpServer.hpp"
+#include "Network/Platform.hpp"
+
+#include <stdexcept>
+#include <system_error>
+
+namespace Library::Network
+{
+    TcpServer::TcpServer(Config config, AcceptHandler handler, ErrorHandler onError) :
+        config(config),
+        handler(std::move(handler)),
+        onError(std::move(onError)),
+        boundPort(0),
+        started(false)
+    {
+        if(!this->handler) throw std::invalid_argument("handler is empty");
+
+        if(this->config.workers == 0) this->config.workers = std::thread::hardware_concurrency();
+        if(this->config.workers == 0) this->config.workers = 1;
+        if(this->config.acceptBatch == 0) this->config.acceptBatch = 1;
+    }
+
+    TcpServer::~TcpServer() noexcept
+    {
+        stop();
+    }
+
+    void TcpServer::start()
+    {
+        if(started) throw std::logic_error("server is already running");
+
+        pool.clear();
+        for(size_t i = 0; i < config.workers; ++i) pool.push_back(std::make_unique<Worker>());
+
+#if defined(__linux__)
+        // One listener per worker; an ephemeral port is resolved by the first bind.
+        uint16_t port = config.address.port();
+        for(auto& worker : pool)
+        {
+            TcpSocket& listener = worker->listener.emplace(config.address.family(), config.dualStack, config.listenerOptions);
+            listener.listen(config.address.withPort(port), config.backlog, true);
+            if(!listener.setNonBlocking(true)) throw Platform::failure("fcntl()");
+            if(port == 0) port = listener.localPort();
+        }
+        boundPort = port;
+#else
+        TcpSocket& listener = shared.emplace(config.address.family(), config.dualStack, config.listenerOptions);
+        listener.listen(config.address, config.backlog);
+        if(!listener.setNonBlocking(true)) throw Platform::failure("fcntl()");
+        boundPort = listener.localPort();
+#endif
+
+        for(auto& worker : pool)
+        {
+            TcpSocket& listener = worker->listener ? *worker->listener : *shared;
+            if(!worker->loop.add(listener.native(), Event::Read, [this, &worker = *worker, &listener](Event)
+            {
+                serve(worker, listener);
+            }))
+            {
+                throw Platform::failure("EventLoop::add()");
+            }
+        }
+
+        for(auto& worker : pool)
+        {
+            worker->thread = std::thread([&loop = worker->loop]
+            {
+                loop.run();
+            });
+        }
+
+        started = true;
+    }
+
+    void TcpServer::stop() noexcept
+    {
+        if(!started) return;
+
+        for(auto& worker : pool) worker->loop.stop();
+        for(auto& worker : pool)
+        {
+            if(worker->thread.joinable()) worker->thread.join();
+        }
+
+        pool.clear();
+        shared.reset();
+        started = false;
+    }
+
+    bool TcpServer::running() const noexcept
+    {
+        return started;
+    }
+
+    uint16_t TcpServer::port() const noexcept
+    {
+        return boundPort;
+    }
+
+    size_t TcpServer::workers() const noexcept
+    {
+        return config.workers;
+    }
+
+    EventLoop& TcpServer::loop(size_t worker) noexcept
+    {
+        return pool[worker]->loop;
+    }
+
+    void TcpServer::serve(Worker& worker, TcpSocket& listener)
+    {
+        for(size_t i = 0; i < config.acceptBatch; ++i)
+        {
+            std::optional<TcpSocket> accepted;
+            Result res = listener.accept(accepted, config.connectionOptions);
+            if(res.type == ResultType::Disconnected) continue;
+            if(res.type == ResultType::Error) backOff(worker, listener, Platform::lastError());
+            if(res.type != ResultType::Data) return;
+
+            try
+            {
+                handler(std::move(*accepted), worker.loop);
+            }
+            catch(...)
+            {
+            }
+        }
+    }
+
+    void TcpServer::backOff(Worker& worker, TcpSocket& listener, int error)
+    {
+        // The listener stays readable while the error lasts; level-triggered, it would
+        // wake this worker again at once.
+        worker.loop.modify(listener.native(), Event::None);
+        worker.loop.runAfter(config.acceptBackoff, [&worker, &listener]
+        {
+            worker.loop.modify(listener.native(), Event::Read);
+        });
+
+        if(!onError) return;
+        try
+        {
+            onError(error);
+        }
+        catch(...)
+        {
+        }
+    }
+}
\ No newline at end of file
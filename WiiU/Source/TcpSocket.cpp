@@ -1,133 +1,288 @@
 #include "Network/TcpSocket.hpp"
+#include "Network/Platform.hpp"
+#include "Network/Probe.hpp"
 #include "Network/Result.hpp"
+#include "Network/SocketAddress.hpp"
 
 #include <optional>
 #include <stdexcept>
-#include <sys/socket.h>
-#include <sys/ioctl.h>
-#include <netinet/in.h>
-#include <netinet/tcp.h>
-#include <arpa/inet.h>
 #include <system_error>
-#include <unistd.h>
 #include <fcntl.h>
-#include <poll.h>
+#include <sys/stat.h>
 
+#if defined(_WIN32)
+#include <io.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 
 namespace Library::Network
 {
-    TcpSocket::TcpSocket()
+    namespace
+    {
+#if defined(__linux__)
+        // Larger spans are sent/received partially, like a short write.
+        constexpr size_t MaxIoVectors = 64;
+
+        // Linux transfers at most this much per sendfile/splice call.
+        constexpr size_t MaxFileChunk = 0x7FFFF000;
+#else
+        constexpr size_t FileChunk = 16 * 1024;
+#endif
+
+#if defined(O_BINARY)
+        constexpr int FileMode = O_RDONLY | O_BINARY;
+#else
+        constexpr int FileMode = O_RDONLY;
+#endif
+    }
+
+    TcpSocket::TcpSocket() : TcpSocket(AddressFamily::IPv4)
+    {
+    }
+
+    TcpSocket::TcpSocket(AddressFamily family, bool dualStack, SocketOptions const & options) :
+        addressFamily(family),
+        noDelay(options.noDelay.value_or(true))
     {
-        fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-        if(fd < 0) throw std::system_error(errno, std::generic_category(), "socket()");
+        fd = openSocket(family, SOCK_STREAM, IPPROTO_TCP, dualStack);
+        if(!Platform::valid(fd)) throw Platform::failure("socket()");
 
-        int opt = 1;
-        int res = ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "setsockopt()");
+        if(!options.apply(fd))
+        {
+            std::system_error error = Platform::failure("setsockopt()");
+            Platform::close(fd);
+            throw error;
+        }
     }
 
     TcpSocket::~TcpSocket() noexcept
     {
-        if(fd < 0) return;
+        if(!Platform::valid(fd)) return;
 
-        ::close(fd);
+        Platform::close(fd);
     }
 
-    TcpSocket::TcpSocket(TcpSocket&& other) noexcept : fd(other.fd)
+    TcpSocket::TcpSocket(TcpSocket&& other) noexcept : fd(other.fd), addressFamily(other.addressFamily), noDelay(other.noDelay)
     {
-        other.fd = -1;
+        other.fd = Platform::Invalid;
     }
 
     TcpSocket& TcpSocket::operator=(TcpSocket&& other) noexcept
     {
         if (this != &other)
         {
-            if (fd != -1) ::close(fd);
+            if (Platform::valid(fd)) Platform::close(fd);
             fd = other.fd;
-            other.fd = -1;
+            addressFamily = other.addressFamily;
+            noDelay = other.noDelay;
+            other.fd = Platform::Invalid;
         }
         return *this;
     }
 
     bool TcpSocket::listen(uint16_t port)
     {
-        if(fd < 0) throw std::logic_error("sockfd is invalid");
+        return listen(port, 64);
+    }
 
-        sockaddr_in addr;
-        std::memset(&addr, 0, sizeof(addr));
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = htonl(INADDR_ANY);
-        addr.sin_port = htons(port);
+    bool TcpSocket::listen(uint16_t port, int backlog, bool reusePort)
+    {
+        return listen(Endpoint::any(addressFamily, port), backlog, reusePort);
+    }
+
+    bool TcpSocket::listen(Endpoint const & local, int backlog, bool reusePort)
+    {
+        if(!Platform::valid(fd)) throw std::logic_error("sockfd is invalid");
+        if(local.family() != addressFamily && !reopen(local.family())) throw Platform::failure("socket()");
+
+        if(reusePort)
+        {
+#if defined(SO_REUSEPORT)
+            int opt = 1;
+            if(!Platform::setOption(fd, SOL_SOCKET, SO_REUSEPORT, opt)) throw Platform::failure("setsockopt()");
+#else
+            Platform::setLastError(Platform::OptionUnsupported);
+            throw Platform::failure("setsockopt()");
+#endif
+        }
 
-        int res = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "bind()");
+        SocketAddress addr;
+        toSocketAddress(local, addr, addressFamily);
 
-        res = ::listen(fd, 64);
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "listen()");
+        int res = ::bind(fd, addr.data(), addr.length);
+        if(res < 0) throw Platform::failure("bind()");
+
+        res = ::listen(fd, backlog);
+        if(res < 0) throw Platform::failure("listen()");
         
         return true;
     }
 
     std::optional<TcpSocket> TcpSocket::accept() noexcept
     {
-        if(fd < 0) return std::nullopt;
+        return accept(SocketOptions{});
+    }
+
+    std::optional<TcpSocket> TcpSocket::accept(SocketOptions const & options) noexcept
+    {
+        std::optional<TcpSocket> accepted;
+        accept(accepted, options);
+        return accepted;
+    }
+
+    Result TcpSocket::accept(std::optional<TcpSocket>& accepted, SocketOptions const & options) noexcept
+    {
+        accepted.reset();
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        SocketFD peer;
+        while(true)
+        {
+            SocketAddress addr;
+            addr.length = SocketAddress::capacity();
+            Probe probe(Metric::TcpAccept);
+#if defined(__linux__)
+            // accept4 hands back a non-blocking socket without the two extra fcntl calls.
+            peer = ::accept4(fd, addr.data(), &addr.length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+            peer = ::accept(fd, addr.data(), &addr.length);
+#endif
+            probe.done(Platform::valid(peer) ? 0 : -1, 0);
+            if(Platform::valid(peer)) break;
+
+            int error = Platform::lastError();
+            if(Platform::interrupted(error)) continue;
+            if(Platform::wouldBlock(error)) return {ResultType::WouldBlock, 0};
+            if(Platform::aborted(error)) return {ResultType::Disconnected, 0};
+            return {ResultType::Error, 0};
+        }
 
-        sockaddr addr;
-        socklen_t size = sizeof(addr);
-        int accepted = ::accept(fd, &addr, &size);
-        if(accepted < 0) return std::nullopt;
+#if !defined(__linux__)
+        if(!Platform::setNonBlocking(peer, true))
+        {
+            Platform::close(peer);
+            return {ResultType::Disconnected, 0};
+        }
+#endif
 
-        int flags = ::fcntl(accepted, F_GETFL, 0);
-        if (flags < 0) return std::nullopt;
-        flags |= O_NONBLOCK;
-        int res = ::fcntl(accepted, F_SETFL, flags | O_NONBLOCK);
-        if(res < 0) return std::nullopt;
+        TcpSocket socket(peer, addressFamily);
+        socket.noDelay = options.noDelay.value_or(true);
+        if(!options.apply(peer) || !socket.applyNoDelay()) return {ResultType::Disconnected, 0};
 
-        int v = 1;
-        res = ::setsockopt(accepted, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
-        if(res < 0) return std::nullopt;
+        accepted.emplace(std::move(socket));
+        return {ResultType::Data, 0};
+    }
 
-        return TcpSocket(accepted);
+    TcpSocket TcpSocket::adopt(SocketFD fd) noexcept
+    {
+        TcpSocket socket(fd, socketFamily(fd));
+        socket.applyNoDelay();
+        return socket;
     }
 
     bool TcpSocket::connect(std::string host, uint16_t port) noexcept
     {
-        if(fd < 0) return false;
+        return connect(std::move(host), port, -1);
+    }
 
-        sockaddr_in addr;
-        std::memset(&addr, 0, sizeof(addr));
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = inet_addr(host.c_str());
-        addr.sin_port = htons(port);
+    bool TcpSocket::connect(std::string host, uint16_t port, int timeoutMs) noexcept
+    {
+        std::optional<Endpoint> endpoint = Endpoint::parse(host, port);
+        if(!endpoint) return false;
+
+        return connect(*endpoint, timeoutMs);
+    }
+
+    bool TcpSocket::connect(Endpoint const & endpoint, int timeoutMs) noexcept
+    {
+        Result res = connectAsync(endpoint);
+        if(res.type == ResultType::Data) return true;
+        if(res.type != ResultType::WouldBlock) return false;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while(true)
+        {
+            int remaining = timeoutMs;
+            if(timeoutMs >= 0)
+            {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                remaining = static_cast<int>(std::max<int64_t>(left.count(), 0));
+            }
+
+            bool ready = waitWrite(remaining);
+            res = finishConnect();
+            if(res.type == ResultType::Data) return true;
+            if(res.type != ResultType::WouldBlock) return false;
+            if(!ready && remaining == 0) return false;
+        }
+    }
+
+    Result TcpSocket::connectAsync(Endpoint const & endpoint) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+        if(endpoint.family() != addressFamily && !reopen(endpoint.family())) return {ResultType::Error, 0};
 
-        int res = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        SocketAddress addr;
+        if(!toSocketAddress(endpoint, addr, addressFamily)) return {ResultType::Error, 0};
+
+        // Non-blocking before connecting, so a blackholed peer never stalls the caller.
+        if(!setNonBlocking(true)) return {ResultType::Error, 0};
+
+        Probe probe(Metric::TcpConnect);
+        int res = ::connect(fd, addr.data(), addr.length);
+        probe.done(res, 0);
         if(res < 0)
         {
-            if(errno != EINPROGRESS) return false;
+            int error = Platform::lastError();
+            if(Platform::connectPending(error)) return {ResultType::WouldBlock, 0};
+            if(!Platform::alreadyConnected(error)) return {ResultType::Error, 0};
         }
 
-        int flags = ::fcntl(fd, F_GETFL, 0);
-        if (flags < 0)  return false;
-        flags |= O_NONBLOCK;
-        res = ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
-        if(res < 0)  return false;
+        if(!applyNoDelay()) return {ResultType::Error, 0};
 
-        int v = 1;
-        res = ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
-        if(res < 0) return false;
+        return {ResultType::Data, 0};
+    }
 
-        return true;
+    Result TcpSocket::finishConnect() noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        int error = 0;
+        if(!Platform::getOption(fd, SOL_SOCKET, SO_ERROR, error) || error != 0) return {ResultType::Error, 0};
+
+        // SO_ERROR is also 0 while the handshake is still running.
+        SocketAddress peer;
+        peer.length = SocketAddress::capacity();
+        int res = ::getpeername(fd, peer.data(), &peer.length);
+        if(res < 0)
+        {
+            if(Platform::notConnected(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        if(!applyNoDelay()) return {ResultType::Error, 0};
+
+        return {ResultType::Data, 0};
     }
 
     Result TcpSocket::send(const void* data, size_t size) noexcept
     {
-        if(fd < 0) return {ResultType::Error, 0};
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
 
-        int res = ::send(fd, data, size, 0);
+        Probe probe(Metric::TcpSend);
+        ptrdiff_t res = Platform::send(fd, data, size, 0);
+        probe.done(res);
         if(res < 0)
         {
-            if(errno == EAGAIN || errno == EWOULDBLOCK) return {ResultType::WouldBlock, 0};
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
             return {ResultType::Error, 0};
         }
 
@@ -138,12 +293,14 @@ namespace Library::Network
 
     Result TcpSocket::recv(void* data, size_t size) noexcept
     {
-        if(fd < 0) return {ResultType::Error, 0};
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
 
-        int res = ::recv(fd, data, size, 0);
+        Probe probe(Metric::TcpRecv);
+        ptrdiff_t res = Platform::recv(fd, data, size, 0);
+        probe.done(res);
         if(res < 0)
         {
-            if(errno == EAGAIN || errno == EWOULDBLOCK) return {ResultType::WouldBlock, 0};
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
             return {ResultType::Error, 0};
         }
 
@@ -152,29 +309,231 @@ namespace Library::Network
         return {ResultType::Data, static_cast<size_t>(res)};
     }
 
+    Result TcpSocket::send(Buffer const & buffer) noexcept
+    {
+        return send(buffer.data(), buffer.size());
+    }
+
+    Result TcpSocket::recv(Buffer& buffer) noexcept
+    {
+        size_t used = buffer.size();
+        if(used == buffer.capacity()) return {ResultType::Error, 0};
+
+        Result res = recv(buffer.data() + used, buffer.capacity() - used);
+        if(res.type == ResultType::Data) buffer.resize(used + res.bytes);
+        return res;
+    }
+
+    Result TcpSocket::sendv(std::span<ConstBufferView const> buffers) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+#if defined(__linux__)
+        iovec iov[MaxIoVectors];
+        size_t count = std::min(buffers.size(), MaxIoVectors);
+        size_t total = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            iov[i].iov_base = const_cast<void*>(buffers[i].data);
+            iov[i].iov_len = buffers[i].size;
+            total += buffers[i].size;
+        }
+
+        // The syscall would return 0 and read as the peer closing.
+        if(total == 0) return {ResultType::Data, 0};
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        Probe probe(Metric::TcpSend);
+        ssize_t res = ::sendmsg(fd, &msg, 0);
+        probe.done(res);
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        if(res == 0) return {ResultType::Disconnected, 0};
+
+        return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        size_t total = 0;
+        for(ConstBufferView const & buffer : buffers)
+        {
+            if(buffer.size == 0) continue;
+
+            Result res = send(buffer.data, buffer.size);
+            if(res.type != ResultType::Data) return total > 0 ? Result{ResultType::Data, total} : res;
+
+            total += res.bytes;
+            if(res.bytes < buffer.size) break;
+        }
+        return {ResultType::Data, total};
+#endif
+    }
+
+    Result TcpSocket::recvv(std::span<MutableBufferView const> buffers) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+#if defined(__linux__)
+        iovec iov[MaxIoVectors];
+        size_t count = std::min(buffers.size(), MaxIoVectors);
+        size_t total = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            iov[i].iov_base = buffers[i].data;
+            iov[i].iov_len = buffers[i].size;
+            total += buffers[i].size;
+        }
+
+        // The syscall would return 0 and read as the peer closing.
+        if(total == 0) return {ResultType::Data, 0};
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        Probe probe(Metric::TcpRecv);
+        ssize_t res = ::recvmsg(fd, &msg, 0);
+        probe.done(res);
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        if(res == 0) return {ResultType::Disconnected, 0};
+
+        return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        size_t total = 0;
+        for(MutableBufferView const & buffer : buffers)
+        {
+            if(buffer.size == 0) continue;
+
+            Result res = recv(buffer.data, buffer.size);
+            if(res.type != ResultType::Data) return total > 0 ? Result{ResultType::Data, total} : res;
+
+            total += res.bytes;
+            if(res.bytes < buffer.size) break;
+        }
+        return {ResultType::Data, total};
+#endif
+    }
+
+    Result TcpSocket::sendFile(int fileFd, uint64_t& offset, size_t length) noexcept
+    {
+        if(!Platform::valid(fd) || fileFd < 0) return {ResultType::Error, 0};
+        if(length == 0) return {ResultType::Data, 0};
+
+        struct stat info;
+        if(::fstat(fileFd, &info) < 0) return {ResultType::Error, 0};
+
+#if defined(__linux__)
+        length = std::min(length, MaxFileChunk);
+
+        Probe probe(Metric::TcpSend);
+        ssize_t res;
+        if(S_ISFIFO(info.st_mode))
+        {
+            // Pipes have no offset; splice moves their pages straight into the socket.
+            res = ::splice(fileFd, nullptr, fd, nullptr, length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        }
+        else
+        {
+            off_t position = static_cast<off_t>(offset);
+            res = ::sendfile(fd, fileFd, &position, length);
+        }
+        probe.done(res);
+
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError()))
+            {
+                // splice can't tell an empty pipe from a full socket; ask the pipe.
+                if(S_ISFIFO(info.st_mode))
+                {
+                    pollfd source{fileFd, POLLIN, 0};
+                    if(::poll(&source, 1, 0) == 0) return {ResultType::SourceWouldBlock, 0};
+                }
+                return {ResultType::WouldBlock, 0};
+            }
+            if(errno == EPIPE || errno == ECONNRESET) return {ResultType::Disconnected, 0};
+            return {ResultType::Error, 0};
+        }
+
+        offset += static_cast<uint64_t>(res);
+        return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        uint8_t buffer[FileChunk];
+        if(!S_ISFIFO(info.st_mode))
+        {
+            if(::lseek(fileFd, static_cast<off_t>(offset), SEEK_SET) < 0) return {ResultType::Error, 0};
+        }
+
+        ssize_t got = ::read(fileFd, buffer, std::min(length, sizeof(buffer)));
+        if(got < 0)
+        {
+            if(errno == EAGAIN || errno == EWOULDBLOCK) return {ResultType::SourceWouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+        if(got == 0) return {ResultType::Data, 0};
+
+        // Unsent bytes are re-read from the advanced offset next time; pipe data would be lost,
+        // so pipes are pushed out completely before returning.
+        Result res = send(buffer, static_cast<size_t>(got));
+        if(res.type != ResultType::Data) return res;
+
+        size_t sent = res.bytes;
+        while(S_ISFIFO(info.st_mode) && sent < static_cast<size_t>(got))
+        {
+            if(!waitWrite(-1)) return {ResultType::Error, sent};
+            res = send(buffer + sent, static_cast<size_t>(got) - sent);
+            if(res.type == ResultType::WouldBlock) continue;
+            if(res.type != ResultType::Data) return {res.type, sent};
+            sent += res.bytes;
+        }
+
+        offset += sent;
+        return {ResultType::Data, sent};
+#endif
+    }
+
+    Result TcpSocket::sendFile(std::string const & path, uint64_t& offset, size_t length) noexcept
+    {
+        int fileFd = ::open(path.c_str(), FileMode);
+        if(fileFd < 0) return {ResultType::Error, 0};
+
+        Result res = sendFile(fileFd, offset, length);
+        ::close(fileFd);
+        return res;
+    }
 
     bool TcpSocket::waitRead(int timeoutMs) noexcept
     {
-        if(fd < 0) return false;
+        if(!Platform::valid(fd)) return false;
 
-        pollfd pfd{};
+        Platform::PollDescriptor pfd{};
         pfd.fd = fd;
         pfd.events = POLLIN;
 
-        int res = ::poll(&pfd, 1, timeoutMs);
+        int res = Platform::poll(&pfd, 1, timeoutMs);
         if(res < 0) return false;
         return (res > 0 && (pfd.revents & POLLIN));
     }
 
     bool TcpSocket::waitWrite(int timeoutMs) noexcept
     {
-        if(fd < 0) return false;
+        if(!Platform::valid(fd)) return false;
 
-        pollfd pfd{};
+        Platform::PollDescriptor pfd{};
         pfd.fd = fd;
         pfd.events = POLLOUT;
 
-        int res = ::poll(&pfd, 1, timeoutMs);
+        int res = Platform::poll(&pfd, 1, timeoutMs);
         if(res < 0) return false;
         return (res > 0 && (pfd.revents & POLLOUT));
     }
@@ -182,12 +541,102 @@ namespace Library::Network
 
     void TcpSocket::shutdown() noexcept
     {
-        if(fd < 0) return;
+        if(!Platform::valid(fd)) return;
         
-        ::shutdown(fd, SHUT_RDWR);
-        ::close(fd);
-        fd = -1;
+        ::shutdown(fd, Platform::ShutdownBoth);
+        Platform::close(fd);
+        fd = Platform::Invalid;
+    }
+
+    bool TcpSocket::tcpInfo(TcpInfo& info) const noexcept
+    {
+#if defined(__linux__)
+        if(!Platform::valid(fd)) return false;
+
+        tcp_info raw{};
+        if(!Platform::getOption(fd, IPPROTO_TCP, TCP_INFO, raw)) return false;
+
+        info.rttUs = raw.tcpi_rtt;
+        info.rttVarianceUs = raw.tcpi_rttvar;
+        info.retransmits = raw.tcpi_retransmits;
+        info.totalRetransmits = raw.tcpi_total_retrans;
+        info.lost = raw.tcpi_lost;
+        info.unacked = raw.tcpi_unacked;
+        info.congestionWindow = raw.tcpi_snd_cwnd;
+        info.slowStartThreshold = raw.tcpi_snd_ssthresh;
+        info.mss = raw.tcpi_snd_mss;
+        return true;
+#else
+        (void)info;
+        return false;
+#endif
     }
 
-    TcpSocket::TcpSocket(SocketFD fd) noexcept : fd(fd) {}
+    bool TcpSocket::setOptions(SocketOptions const & options) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+        if(!options.apply(fd)) return false;
+        if(options.noDelay) noDelay = *options.noDelay;
+        return true;
+    }
+
+    SocketOptions TcpSocket::options() const noexcept
+    {
+        if(!Platform::valid(fd)) return SocketOptions();
+
+        return SocketOptions::query(fd);
+    }
+
+    bool TcpSocket::setNonBlocking(bool enable) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+        return Platform::setNonBlocking(fd, enable);
+    }
+
+    uint16_t TcpSocket::localPort() const noexcept
+    {
+        return localEndpoint().port();
+    }
+
+    Endpoint TcpSocket::localEndpoint() const noexcept
+    {
+        if(!Platform::valid(fd)) return Endpoint();
+
+        return Network::localEndpoint(fd);
+    }
+
+    AddressFamily TcpSocket::family() const noexcept
+    {
+        return addressFamily;
+    }
+
+    SocketFD TcpSocket::native() const noexcept
+    {
+        return fd;
+    }
+
+    TcpSocket::TcpSocket(SocketFD fd, AddressFamily family) noexcept : fd(fd), addressFamily(family), noDelay(true) {}
+
+    // Nagle is off by default; setOptions or the constructor's options can keep it on.
+    bool TcpSocket::applyNoDelay() noexcept
+    {
+        if(!noDelay) return true;
+
+        int v = 1;
+        return Platform::setOption(fd, IPPROTO_TCP, TCP_NODELAY, v);
+    }
+
+    // Only before bind or connect; options set through native() do not carry over.
+    bool TcpSocket::reopen(AddressFamily family) noexcept
+    {
+        SocketFD replacement = openSocket(family, SOCK_STREAM, IPPROTO_TCP, false);
+        if(!Platform::valid(replacement)) return false;
+
+        Platform::close(fd);
+        fd = replacement;
+        addressFamily = family;
+        return true;
+    }
 }
\ No newline at end of file
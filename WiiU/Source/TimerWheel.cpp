@@ -0,0 +1,255 @@
+#include "Network/TimerWheel.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Library::Network
+{
+    TimerWheel::TimerWheel(Clock::time_point origin) noexcept :
+        origin(origin),
+        current(0),
+        active(0),
+        freeList(Nil)
+    {
+        heads.fill(Nil);
+        for(auto& level : occupied) level.fill(0);
+    }
+
+    TimerWheel::TimerId TimerWheel::add(Clock::time_point now, std::chrono::milliseconds delay, std::function<void()> job)
+    {
+        uint32_t index;
+        if(freeList != Nil)
+        {
+            index = freeList;
+            freeList = nodes[index].next;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        Node& node = nodes[index];
+        node.job = std::move(job);
+        node.deadline = deadline(now, delay);
+        file(index);
+        ++active;
+
+        return (static_cast<TimerId>(node.generation) << 32) | (index + 1);
+    }
+
+    bool TimerWheel::cancel(TimerId id) noexcept
+    {
+        uint32_t index = find(id);
+        if(index == Nil) return false;
+
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    bool TimerWheel::rearm(TimerId id, Clock::time_point now, std::chrono::milliseconds delay) noexcept
+    {
+        uint32_t index = find(id);
+        if(index == Nil) return false;
+
+        unlink(index);
+        nodes[index].deadline = deadline(now, delay);
+        file(index);
+        return true;
+    }
+
+    int64_t TimerWheel::timeout(Clock::time_point now) const noexcept
+    {
+        if(active == 0) return -1;
+        if(heads[Due] != Nil) return 0;
+
+        Clock::time_point at = origin + std::chrono::milliseconds(nextTick());
+        if(at <= now) return 0;
+        return std::chrono::ceil<std::chrono::milliseconds>(at - now).count();
+    }
+
+    void TimerWheel::expire(Clock::time_point now, std::vector<std::function<void()>>& jobs)
+    {
+        drain(Due, jobs);
+
+        // Jump from one occupied slot to the next, so an idle stretch costs nothing
+        // per elapsed tick and rounds with nothing to cascade are skipped.
+        uint64_t limit = tick(now);
+        while(active > 0)
+        {
+            uint64_t next = nextTick();
+            if(next > limit) break;
+
+            current = next;
+            if((current & SlotMask) == 0)
+            {
+                // Timers due exactly on the boundary come down as Due.
+                cascade();
+                drain(Due, jobs);
+            }
+            drain(static_cast<uint16_t>(current & SlotMask), jobs);
+        }
+
+        // Nothing is due before limit; timers added from now on are filed against it.
+        current = std::max(current, limit);
+    }
+
+    size_t TimerWheel::size() const noexcept
+    {
+        return active;
+    }
+
+    // A level's next occupied slot comes due when the levels below it wrap; level 0
+    // slots are exact deadlines, the others the tick their timers cascade down.
+    uint64_t TimerWheel::nextTick() const noexcept
+    {
+        uint64_t next = ~uint64_t(0);
+        for(unsigned level = 0; level < Levels; ++level)
+        {
+            unsigned shift = SlotBits * level;
+            uint64_t position = current >> shift;
+            unsigned distance = nextSlot(level, static_cast<unsigned>((position + 1) & SlotMask));
+            if(distance == Slots) continue;
+
+            next = std::min(next, (position + 1 + distance) << shift);
+        }
+        return next;
+    }
+
+    uint64_t TimerWheel::tick(Clock::time_point now) const noexcept
+    {
+        if(now <= origin) return 0;
+        return static_cast<uint64_t>(std::chrono::floor<std::chrono::milliseconds>(now - origin).count());
+    }
+
+    // Rounded up, so a timer never fires before its full delay has passed.
+    uint64_t TimerWheel::deadline(Clock::time_point now, std::chrono::milliseconds delay) const noexcept
+    {
+        if(delay <= std::chrono::milliseconds(0)) return 0;
+
+        uint64_t start = now <= origin ? 0 : static_cast<uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(now - origin).count());
+        return start + static_cast<uint64_t>(delay.count());
+    }
+
+    uint32_t TimerWheel::find(TimerId id) const noexcept
+    {
+        uint32_t index = static_cast<uint32_t>(id) - 1;
+        if(index >= nodes.size()) return Nil;
+
+        Node const & node = nodes[index];
+        if(node.generation != static_cast<uint32_t>(id >> 32) || node.bucket == Unlinked) return Nil;
+        return index;
+    }
+
+    // Level l holds deadlines less than 2^(8(l+1)) ticks after current, in the slot of
+    // their l-th byte; the slot cascades to the levels below when current reaches it.
+    void TimerWheel::file(uint32_t index) noexcept
+    {
+        uint64_t target = nodes[index].deadline;
+        if(target <= current)
+        {
+            link(index, Due);
+            return;
+        }
+
+        // Beyond the top level: park in the last slot it reaches and re-file from there.
+        uint64_t delta = target - current;
+        constexpr uint64_t Span = uint64_t(1) << (SlotBits * Levels);
+        if(delta >= Span) target = current + Span - 1;
+
+        unsigned level = (std::bit_width(target - current) - 1) / SlotBits;
+        unsigned slot = static_cast<unsigned>((target >> (SlotBits * level)) & SlotMask);
+        link(index, static_cast<uint16_t>(level * Slots + slot));
+    }
+
+    void TimerWheel::link(uint32_t index, uint16_t bucket) noexcept
+    {
+        Node& node = nodes[index];
+        node.bucket = bucket;
+        node.prev = Nil;
+        node.next = heads[bucket];
+        if(node.next != Nil) nodes[node.next].prev = index;
+        heads[bucket] = index;
+
+        if(bucket < Due) occupied[bucket / Slots][(bucket % Slots) / 64] |= uint64_t(1) << (bucket % 64);
+    }
+
+    void TimerWheel::unlink(uint32_t index) noexcept
+    {
+        Node& node = nodes[index];
+        if(node.prev != Nil) nodes[node.prev].next = node.next;
+        else heads[node.bucket] = node.next;
+        if(node.next != Nil) nodes[node.next].prev = node.prev;
+
+        if(node.bucket < Due && heads[node.bucket] == Nil)
+        {
+            occupied[node.bucket / Slots][(node.bucket % Slots) / 64] &= ~(uint64_t(1) << (node.bucket % 64));
+        }
+        node.bucket = Unlinked;
+    }
+
+    void TimerWheel::release(uint32_t index) noexcept
+    {
+        Node& node = nodes[index];
+        node.job = nullptr;
+        ++node.generation;
+        node.next = freeList;
+        freeList = index;
+        --active;
+    }
+
+    // current has just reached a new level 0 round: pull the level 1 slot for it down,
+    // and the level 2 slot when level 1 wrapped as well, and so on.
+    void TimerWheel::cascade() noexcept
+    {
+        for(unsigned level = 1; level < Levels; ++level)
+        {
+            unsigned slot = static_cast<unsigned>((current >> (SlotBits * level)) & SlotMask);
+            uint16_t bucket = static_cast<uint16_t>(level * Slots + slot);
+
+            uint32_t index = heads[bucket];
+            while(index != Nil)
+            {
+                uint32_t next = nodes[index].next;
+                unlink(index);
+                file(index);
+                index = next;
+            }
+
+            if(slot != 0) break;
+        }
+    }
+
+    void TimerWheel::drain(uint16_t bucket, std::vector<std::function<void()>>& jobs)
+    {
+        while(heads[bucket] != Nil)
+        {
+            uint32_t index = heads[bucket];
+            unlink(index);
+            jobs.push_back(std::move(nodes[index].job));
+            release(index);
+        }
+    }
+
+    unsigned TimerWheel::nextSlot(unsigned level, unsigned from) const noexcept
+    {
+        auto const & bits = occupied[level];
+        auto first = [&bits](unsigned begin, unsigned end) noexcept
+        {
+            for(unsigned i = begin; i < end; i = (i / 64 + 1) * 64)
+            {
+                uint64_t word = bits[i / 64] >> (i % 64);
+                if(word != 0) return std::min(i + static_cast<unsigned>(std::countr_zero(word)), end);
+            }
+            return end;
+        };
+
+        unsigned slot = first(from, Slots);
+        if(slot < Slots) return slot - from;
+
+        slot = first(0, from);
+        if(slot < from) return Slots - from + slot;
+        return Slots;
+    }
+}
\ No newline at end of file
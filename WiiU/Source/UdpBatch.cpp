@@ -0,0 +1,249 @@
+#include "Network/UdpBatch.hpp"
+#include "Network/Platform.hpp"
+#include "Network/Probe.hpp"
+#include "Network/SocketAddress.hpp"
+
+namespace Library::Network
+{
+#if defined(__linux__)
+    namespace
+    {
+        size_t transferred(std::vector<mmsghdr> const & headers, int count) noexcept
+        {
+            size_t bytes = 0;
+            for(int i = 0; i < count; ++i) bytes += headers[static_cast<size_t>(i)].msg_len;
+            return bytes;
+        }
+    }
+#endif
+
+    struct UdpBatch::Native
+    {
+#if defined(__linux__)
+        std::vector<mmsghdr> headers;
+        std::vector<iovec> iov;
+        std::vector<SocketAddress> addrs;
+
+        // Room for each slot's destination; only receives pass it to the kernel.
+        struct Control
+        {
+            alignas(cmsghdr) char bytes[DestinationControl];
+        };
+        std::vector<Control> control;
+
+        explicit Native(size_t capacity) : headers(capacity), iov(capacity), addrs(capacity), control(capacity)
+        {
+            for(size_t i = 0; i < capacity; ++i)
+            {
+                msghdr& msg = headers[i].msg_hdr;
+                msg.msg_name = addrs[i].data();
+                msg.msg_iov = &iov[i];
+                msg.msg_iovlen = 1;
+            }
+        }
+#else
+        explicit Native(size_t) {}
+#endif
+    };
+
+    UdpBatch::UdpBatch(size_t capacity) :
+        datagrams(capacity, Datagram{nullptr, 0, 0, Endpoint(), Endpoint()}),
+        native(std::make_unique<Native>(capacity)),
+        count(0)
+    {
+    }
+
+    UdpBatch::~UdpBatch() noexcept = default;
+
+    UdpBatch::UdpBatch(UdpBatch&& other) noexcept = default;
+    UdpBatch& UdpBatch::operator=(UdpBatch&& other) noexcept = default;
+
+    bool UdpBatch::push(Endpoint const & peer, void const * data, size_t size) noexcept
+    {
+        if(count == datagrams.size()) return false;
+
+        datagrams[count++] = {const_cast<void*>(data), size, size, peer, Endpoint()};
+        return true;
+    }
+
+    void UdpBatch::setBuffer(size_t index, void * data, size_t capacity) noexcept
+    {
+        Datagram& datagram = datagrams[index];
+        datagram.data = data;
+        datagram.capacity = capacity;
+        datagram.size = 0;
+    }
+
+    void UdpBatch::clear() noexcept
+    {
+        count = 0;
+    }
+
+    size_t UdpBatch::size() const noexcept
+    {
+        return count;
+    }
+
+    size_t UdpBatch::capacity() const noexcept
+    {
+        return datagrams.size();
+    }
+
+    UdpBatch::Datagram& UdpBatch::operator[](size_t index) noexcept
+    {
+        return datagrams[index];
+    }
+
+    UdpBatch::Datagram const & UdpBatch::operator[](size_t index) const noexcept
+    {
+        return datagrams[index];
+    }
+
+    UdpBatch::Datagram* UdpBatch::begin() noexcept
+    {
+        return datagrams.data();
+    }
+
+    UdpBatch::Datagram* UdpBatch::end() noexcept
+    {
+        return datagrams.data() + count;
+    }
+
+    UdpBatch::Datagram const * UdpBatch::begin() const noexcept
+    {
+        return datagrams.data();
+    }
+
+    UdpBatch::Datagram const * UdpBatch::end() const noexcept
+    {
+        return datagrams.data() + count;
+    }
+
+    Result UdpBatch::transmit(SocketFD fd, AddressFamily family, size_t first) noexcept
+    {
+        if(first >= count) return {ResultType::Data, 0};
+
+#if defined(__linux__)
+        size_t n = count - first;
+        for(size_t i = 0; i < n; ++i)
+        {
+            Datagram const & datagram = datagrams[first + i];
+
+            SocketAddress& addr = native->addrs[i];
+            if(!toSocketAddress(datagram.peer, addr, family))
+            {
+                // Send what precedes the unsupported peer; it fails on its own next time.
+                if(i == 0) return {ResultType::Error, 0};
+                n = i;
+                break;
+            }
+
+            native->iov[i].iov_base = datagram.data;
+            native->iov[i].iov_len = datagram.size;
+
+            msghdr& msg = native->headers[i].msg_hdr;
+            msg.msg_namelen = addr.length;
+            msg.msg_control = nullptr;
+            msg.msg_controllen = 0;
+        }
+
+        Probe probe(Metric::UdpSend);
+        int res = ::sendmmsg(fd, native->headers.data(), static_cast<unsigned int>(n), 0);
+        probe.done(res, transferred(native->headers, res));
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        size_t sent = 0;
+        for(size_t i = first; i < count; ++i)
+        {
+            Datagram const & datagram = datagrams[i];
+
+            SocketAddress addr;
+            if(!toSocketAddress(datagram.peer, addr, family))
+            {
+                if(sent > 0) break;
+                return {ResultType::Error, 0};
+            }
+
+            Probe probe(Metric::UdpSend);
+            ptrdiff_t res = Platform::sendTo(fd, datagram.data, datagram.size, 0, addr.data(), addr.length);
+            probe.done(res);
+            if(res < 0)
+            {
+                if(sent > 0) break;
+                if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+                return {ResultType::Error, 0};
+            }
+            ++sent;
+        }
+        return {ResultType::Data, sent};
+#endif
+    }
+
+    Result UdpBatch::receive(SocketFD fd) noexcept
+    {
+        count = 0;
+        if(datagrams.empty()) return {ResultType::Data, 0};
+
+#if defined(__linux__)
+        size_t n = datagrams.size();
+        for(size_t i = 0; i < n; ++i)
+        {
+            native->iov[i].iov_base = datagrams[i].data;
+            native->iov[i].iov_len = datagrams[i].capacity;
+
+            msghdr& msg = native->headers[i].msg_hdr;
+            msg.msg_namelen = SocketAddress::capacity();
+            msg.msg_control = native->control[i].bytes;
+            msg.msg_controllen = sizeof(native->control[i].bytes);
+        }
+
+        Probe probe(Metric::UdpRecv);
+        int res = ::recvmmsg(fd, native->headers.data(), static_cast<unsigned int>(n), 0, nullptr);
+        probe.done(res, transferred(native->headers, res));
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        count = static_cast<size_t>(res);
+        for(size_t i = 0; i < count; ++i)
+        {
+            Datagram& datagram = datagrams[i];
+            datagram.size = native->headers[i].msg_len;
+            datagram.peer = fromSocketAddress(native->addrs[i].data(), native->headers[i].msg_hdr.msg_namelen);
+            datagram.destination = destinationAddress(native->headers[i].msg_hdr);
+        }
+
+        return {ResultType::Data, count};
+#else
+        for(Datagram& datagram : datagrams)
+        {
+            SocketAddress addr;
+            addr.length = SocketAddress::capacity();
+
+            Probe probe(Metric::UdpRecv);
+            ptrdiff_t res = Platform::recvFrom(fd, datagram.data, datagram.capacity, 0, addr.data(), &addr.length);
+            probe.done(res);
+            if(res < 0)
+            {
+                if(count > 0) break;
+                if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+                return {ResultType::Error, 0};
+            }
+
+            datagram.size = static_cast<size_t>(res);
+            datagram.peer = fromSocketAddress(addr);
+            datagram.destination = Endpoint();
+            ++count;
+        }
+        return {ResultType::Data, count};
+#endif
+    }
+}
\ No newline at end of file
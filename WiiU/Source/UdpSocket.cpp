@@ -1,134 +1,659 @@
 #include "Network/UdpSocket.hpp"
+#include "Network/Platform.hpp"
+#include "Network/Probe.hpp"
 #include "Network/Result.hpp"
+#include "Network/SocketAddress.hpp"
 
-#include <sys/socket.h>
-#include <sys/ioctl.h>
-#include <netinet/in.h>
-#include <netinet/tcp.h>
-#include <arpa/inet.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <poll.h>
+#if defined(__linux__)
+#include <netinet/udp.h>
+#endif
 
+#include <algorithm>
 #include <cstring>
 #include <system_error>
 
 namespace Library::Network
 {
-    UdpSocket::UdpSocket()
+    namespace
     {
-        fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-        if(fd < 0) throw std::system_error(errno, std::generic_category(), "socket()");
+        // Limits of one segmented send: UDP_MAX_SEGMENTS on older kernels and the
+        // largest payload an IPv4 datagram can carry.
+        constexpr size_t MaxSegments = 64;
+        constexpr size_t MaxPayload = 65507;
+
+        // Sends length bytes as consecutive segments, one datagram each; returns the
+        // bytes of the segments sent, or -1 with the last error set when none went out.
+        ptrdiff_t sendEach(SocketFD fd, SocketAddress const & addr, uint8_t const * data, size_t length, size_t segmentSize) noexcept
+        {
+#if defined(__linux__)
+            mmsghdr headers[MaxSegments] = {};
+            iovec iov[MaxSegments];
+
+            unsigned int n = 0;
+            for(size_t offset = 0; offset < length; offset += segmentSize, ++n)
+            {
+                iov[n].iov_base = const_cast<uint8_t*>(data + offset);
+                iov[n].iov_len = std::min(segmentSize, length - offset);
+
+                msghdr& msg = headers[n].msg_hdr;
+                msg.msg_name = const_cast<sockaddr*>(addr.data());
+                msg.msg_namelen = addr.length;
+                msg.msg_iov = &iov[n];
+                msg.msg_iovlen = 1;
+            }
+
+            Probe probe(Metric::UdpSend);
+            int res = ::sendmmsg(fd, headers, n, 0);
+            size_t bytes = res > 0 ? std::min(static_cast<size_t>(res) * segmentSize, length) : 0;
+            probe.done(res, bytes);
+            if(res < 0) return -1;
+
+            return static_cast<ptrdiff_t>(bytes);
+#else
+            size_t sent = 0;
+            while(sent < length)
+            {
+                size_t size = std::min(segmentSize, length - sent);
+
+                Probe probe(Metric::UdpSend);
+                ptrdiff_t res = Platform::sendTo(fd, data + sent, size, 0, addr.data(), addr.length);
+                probe.done(res);
+                if(res < 0)
+                {
+                    if(sent > 0) break;
+                    return -1;
+                }
+                sent += size;
+            }
+            return static_cast<ptrdiff_t>(sent);
+#endif
+        }
+
+#if defined(UDP_SEGMENT)
+        // One sendmsg the kernel splits into segmentSize datagrams; all or nothing.
+        ptrdiff_t sendSegmented(SocketFD fd, SocketAddress const & addr, uint8_t const * data, size_t length, size_t segmentSize) noexcept
+        {
+            iovec iov{const_cast<uint8_t*>(data), length};
+
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+            msghdr msg{};
+            msg.msg_name = const_cast<sockaddr*>(addr.data());
+            msg.msg_namelen = addr.length;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = IPPROTO_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t size = static_cast<uint16_t>(segmentSize);
+            std::memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+
+            Probe probe(Metric::UdpSend);
+            ptrdiff_t res = ::sendmsg(fd, &msg, 0);
+            probe.done(res);
+            return res;
+        }
+#endif
+
+        // IP_MULTICAST_IF takes an address almost everywhere; Linux and Winsock also
+        // accept an interface index, each in its own form.
+        bool multicastInterface4(SocketFD fd, uint32_t interfaceIndex) noexcept
+        {
+#if defined(__linux__)
+            ip_mreqn req{};
+            req.imr_ifindex = static_cast<int>(interfaceIndex);
+            return Platform::setOption(fd, IPPROTO_IP, IP_MULTICAST_IF, req);
+#elif defined(_WIN32)
+            // Addresses in 0.0.0.0/8 are read as an index in network byte order.
+            in_addr addr;
+            addr.s_addr = htonl(interfaceIndex);
+            return Platform::setOption(fd, IPPROTO_IP, IP_MULTICAST_IF, addr);
+#elif defined(IP_MULTICAST_IF)
+            if(interfaceIndex != 0)
+            {
+                Platform::setLastError(Platform::OptionUnsupported);
+                return false;
+            }
+            in_addr addr;
+            addr.s_addr = htonl(INADDR_ANY);
+            return Platform::setOption(fd, IPPROTO_IP, IP_MULTICAST_IF, addr);
+#else
+            (void)fd;
+            (void)interfaceIndex;
+            Platform::setLastError(Platform::OptionUnsupported);
+            return false;
+#endif
+        }
+
+        // Sets an int multicast option at the IPv4 or IPv6 level; on IPv6 sockets the
+        // IPv4 form is applied too, for a dual-stack socket's IPv4 traffic.
+        bool multicastOption(SocketFD fd, AddressFamily family, [[maybe_unused]] int v4Name, [[maybe_unused]] int v6Name, int value) noexcept
+        {
+#if defined(NETWORK_HAS_IPV6)
+            if(family == AddressFamily::IPv6)
+            {
+                if(!Platform::setOption(fd, IPPROTO_IPV6, v6Name, value)) return false;
+                Platform::setOption(fd, IPPROTO_IP, v4Name, value);
+                return true;
+            }
+#else
+            (void)family;
+#endif
+            if(v4Name < 0)
+            {
+                Platform::setLastError(Platform::OptionUnsupported);
+                return false;
+            }
+            return Platform::setOption(fd, IPPROTO_IP, v4Name, value);
+        }
+    }
+
+    UdpSocket::UdpSocket() : UdpSocket(AddressFamily::IPv4)
+    {
+    }
+
+    UdpSocket::UdpSocket(AddressFamily family, bool dualStack, SocketOptions const & options) : addressFamily(family), offloadSegments(false)
+    {
+        fd = openSocket(family, SOCK_DGRAM, IPPROTO_UDP, dualStack);
+        if(!Platform::valid(fd)) throw Platform::failure("socket()");
 
         int opt = 1;
-        int res = ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "setsockopt()");
+        if(!Platform::setOption(fd, SOL_SOCKET, SO_BROADCAST, opt) || !options.apply(fd))
+        {
+            std::system_error error = Platform::failure("setsockopt()");
+            Platform::close(fd);
+            throw error;
+        }
+        if(!Platform::setNonBlocking(fd, true))
+        {
+            std::system_error error = Platform::failure("setNonBlocking()");
+            Platform::close(fd);
+            throw error;
+        }
 
-        opt = 1;
-        res = ::setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &opt, sizeof(opt));
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "setsockopt()");
+#if defined(__linux__)
+        // Lets recvFrom/recvBatch report each datagram's destination; it only costs
+        // a control message on reads that ask for it.
+        receiveDestination(fd, family);
+#endif
 
-        int flags = ::fcntl(fd, F_GETFL, 0);
-        if (flags < 0) return;
-        flags |= O_NONBLOCK;
-        res = ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "fcntl()");
+#if defined(UDP_SEGMENT)
+        // Kernels before 4.18 ignore the control message and would send one oversized
+        // datagram, so segmentation is only offloaded where the option is known.
+        int segment = 0;
+        offloadSegments = Platform::getOption(fd, IPPROTO_UDP, UDP_SEGMENT, segment);
+#endif
     }
 
     UdpSocket::~UdpSocket()
     {
-        if(fd < 0) return;
+        if(!Platform::valid(fd)) return;
 
-        ::close(fd);
+        Platform::close(fd);
     }
 
     bool UdpSocket::bind(uint16_t port)
     {
-        if(fd < 0) throw std::logic_error("sockfd is invalid");
+        return bind(Endpoint::any(addressFamily, port));
+    }
 
-        sockaddr_in addr;
-        std::memset(&addr, 0, sizeof(addr));
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = htonl(INADDR_ANY);
-        addr.sin_port = htons(port);
-        
-        int res = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
-        if(res < 0) throw std::system_error(errno, std::generic_category(), "bind()");
+    bool UdpSocket::bind(Endpoint const & local)
+    {
+        if(!Platform::valid(fd)) throw std::logic_error("sockfd is invalid");
+
+        SocketAddress addr;
+        if(!toSocketAddress(local, addr, addressFamily))
+        {
+            Platform::setLastError(Platform::FamilyUnsupported);
+            throw Platform::failure("bind()");
+        }
+
+        int res = ::bind(fd, addr.data(), addr.length);
+        if(res < 0) throw Platform::failure("bind()");
 
         return true;
     }
 
-    Result UdpSocket::sendTo(std::string const & host, uint16_t port, void const * data, size_t size) noexcept
+    Result UdpSocket::sendTo(Endpoint const & endpoint, void const * data, size_t size) noexcept
     {
-        if(fd < 0) return {ResultType::Error, 0};
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
 
-        sockaddr_in addr;
-        std::memset(&addr, 0, sizeof(addr));
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = inet_addr(host.c_str());
-        addr.sin_port = htons(port);
+        SocketAddress addr;
+        if(!toSocketAddress(endpoint, addr, addressFamily)) return {ResultType::Error, 0};
 
-        int res = ::sendto(fd, data, size, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        Probe probe(Metric::UdpSend);
+        ptrdiff_t res = Platform::sendTo(fd, data, size, 0, addr.data(), addr.length);
+        probe.done(res);
         if(res < 0)
         {
-            if(errno == EAGAIN || errno == EWOULDBLOCK) return {ResultType::WouldBlock, 0};
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
             return {ResultType::Error, 0};
         }
         
         return {ResultType::Data, static_cast<size_t>(res)};
     }
 
+    Result UdpSocket::recvFrom(Endpoint & endpoint, void * data, size_t size) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        SocketAddress addr;
+        addr.length = SocketAddress::capacity();
+
+        Probe probe(Metric::UdpRecv);
+        ptrdiff_t res = Platform::recvFrom(fd, data, size, 0, addr.data(), &addr.length);
+        probe.done(res);
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        endpoint = fromSocketAddress(addr);
+        return {ResultType::Data, static_cast<size_t>(res)};
+    }
+
+    Result UdpSocket::recvFrom(Endpoint & source, Endpoint & destination, void * data, size_t size) noexcept
+    {
+#if defined(__linux__)
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        SocketAddress addr;
+        iovec iov{data, size};
+
+        alignas(cmsghdr) char control[DestinationControl];
+        msghdr msg{};
+        msg.msg_name = addr.data();
+        msg.msg_namelen = SocketAddress::capacity();
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        Probe probe(Metric::UdpRecv);
+        ptrdiff_t res = ::recvmsg(fd, &msg, 0);
+        probe.done(res);
+        if(res < 0)
+        {
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+            return {ResultType::Error, 0};
+        }
+
+        addr.length = msg.msg_namelen;
+        source = fromSocketAddress(addr);
+        destination = destinationAddress(msg);
+        return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        destination = Endpoint();
+        return recvFrom(source, data, size);
+#endif
+    }
+
+    Result UdpSocket::sendTo(Endpoint const & endpoint, Buffer const & buffer) noexcept
+    {
+        return sendTo(endpoint, buffer.data(), buffer.size());
+    }
+
+    Result UdpSocket::recvFrom(Endpoint & endpoint, Buffer& buffer) noexcept
+    {
+        if(buffer.capacity() == 0) return {ResultType::Error, 0};
+
+        Result res = recvFrom(endpoint, buffer.data(), buffer.capacity());
+        buffer.resize(res.type == ResultType::Data ? res.bytes : 0);
+        return res;
+    }
+
+    Result UdpSocket::sendTo(std::string const & host, uint16_t port, void const * data, size_t size) noexcept
+    {
+        std::optional<Endpoint> endpoint = Endpoint::parse(host, port);
+        if(!endpoint) return {ResultType::Error, 0};
+
+        return sendTo(*endpoint, data, size);
+    }
+
     Result UdpSocket::recvFrom(std::string & host, uint16_t & port, void * data, size_t size) noexcept
     {
-        if(fd < 0) return {ResultType::Error, 0};
+        Endpoint endpoint;
+        Result res = recvFrom(endpoint, data, size);
+        if(res.type != ResultType::Data) return res;
+
+        host = endpoint.address();
+        port = endpoint.port();
+        return res;
+    }
+
+    Result UdpSocket::sendBatch(UdpBatch& batch, size_t first) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        return batch.transmit(fd, addressFamily, first);
+    }
+
+    Result UdpSocket::recvBatch(UdpBatch& batch) noexcept
+    {
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        return batch.receive(fd);
+    }
+
+    Result UdpSocket::sendSegments(Endpoint const & endpoint, void const * data, size_t size, size_t segmentSize) noexcept
+    {
+        if(!Platform::valid(fd) || segmentSize == 0 || segmentSize > MaxPayload) return {ResultType::Error, 0};
+        if(size <= segmentSize) return sendTo(endpoint, data, size);
 
-        sockaddr_in addr;
-        socklen_t addrSize = sizeof(addr);
+        SocketAddress addr;
+        if(!toSocketAddress(endpoint, addr, addressFamily)) return {ResultType::Error, 0};
 
-        int res = ::recvfrom(fd, data, size, 0, reinterpret_cast<sockaddr*>(&addr), &addrSize);
+        uint8_t const * bytes = static_cast<uint8_t const *>(data);
+        size_t chunk = std::min(MaxSegments, MaxPayload / segmentSize) * segmentSize;
+        size_t sent = 0;
+        while(sent < size)
+        {
+            size_t length = std::min(chunk, size - sent);
+
+            ptrdiff_t res = -1;
+#if defined(UDP_SEGMENT)
+            if(offloadSegments)
+            {
+                res = sendSegmented(fd, addr, bytes + sent, length, segmentSize);
+
+                // EIO: the outgoing device can't checksum segments, which won't change;
+                // EINVAL: segmentSize exceeds the path MTU, so send this call in software.
+                int error = Platform::lastError();
+                if(res < 0 && error == EIO) offloadSegments = false;
+                if(res < 0 && (error == EIO || error == EINVAL)) res = sendEach(fd, addr, bytes + sent, length, segmentSize);
+            }
+            else
+#endif
+            {
+                res = sendEach(fd, addr, bytes + sent, length, segmentSize);
+            }
+
+            if(res < 0)
+            {
+                if(sent > 0) break;
+                if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
+                return {ResultType::Error, 0};
+            }
+
+            sent += static_cast<size_t>(res);
+            if(static_cast<size_t>(res) < length) break;
+        }
+
+        return {ResultType::Data, sent};
+    }
+
+    Result UdpSocket::recvSegments(Endpoint & endpoint, void * data, size_t size, size_t& segmentSize) noexcept
+    {
+#if defined(UDP_GRO)
+        if(!Platform::valid(fd)) return {ResultType::Error, 0};
+
+        SocketAddress addr;
+        iovec iov{data, size};
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int)) + DestinationControl];
+        msghdr msg{};
+        msg.msg_name = addr.data();
+        msg.msg_namelen = SocketAddress::capacity();
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        Probe probe(Metric::UdpRecv);
+        ptrdiff_t res = ::recvmsg(fd, &msg, 0);
+        probe.done(res);
         if(res < 0)
         {
-            if(errno == EAGAIN || errno == EWOULDBLOCK) return {ResultType::WouldBlock, 0};
+            if(Platform::wouldBlock(Platform::lastError())) return {ResultType::WouldBlock, 0};
             return {ResultType::Error, 0};
         }
 
-        host = inet_ntoa(addr.sin_addr);
-        port = ntohs(addr.sin_port);
+        segmentSize = static_cast<size_t>(res);
+        for(cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if(cmsg->cmsg_level != IPPROTO_UDP || cmsg->cmsg_type != UDP_GRO) continue;
+
+            int coalesced;
+            std::memcpy(&coalesced, CMSG_DATA(cmsg), sizeof(coalesced));
+            if(coalesced > 0) segmentSize = std::min(segmentSize, static_cast<size_t>(coalesced));
+        }
+
+        addr.length = msg.msg_namelen;
+        endpoint = fromSocketAddress(addr);
         return {ResultType::Data, static_cast<size_t>(res)};
+#else
+        Result res = recvFrom(endpoint, data, size);
+        if(res.type == ResultType::Data) segmentSize = res.bytes;
+        return res;
+#endif
+    }
+
+    bool UdpSocket::setReceiveOffload(bool enabled) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+#if defined(UDP_GRO)
+        int opt = enabled ? 1 : 0;
+        return Platform::setOption(fd, IPPROTO_UDP, UDP_GRO, opt);
+#else
+        // Reads stay one datagram each, which recvSegments reports correctly.
+        if(!enabled) return true;
+        Platform::setLastError(Platform::OptionUnsupported);
+        return false;
+#endif
+    }
+
+    bool UdpSocket::segmentOffload() const noexcept
+    {
+        return offloadSegments;
+    }
+
+    bool UdpSocket::joinGroup(Endpoint const & group, uint32_t interfaceIndex) noexcept
+    {
+        return membership(group, nullptr, interfaceIndex, true);
+    }
+
+    bool UdpSocket::leaveGroup(Endpoint const & group, uint32_t interfaceIndex) noexcept
+    {
+        return membership(group, nullptr, interfaceIndex, false);
+    }
+
+    bool UdpSocket::joinGroup(Endpoint const & group, Endpoint const & source, uint32_t interfaceIndex) noexcept
+    {
+        return membership(group, &source, interfaceIndex, true);
+    }
+
+    bool UdpSocket::leaveGroup(Endpoint const & group, Endpoint const & source, uint32_t interfaceIndex) noexcept
+    {
+        return membership(group, &source, interfaceIndex, false);
+    }
+
+    bool UdpSocket::setMulticastInterface(uint32_t interfaceIndex) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+#if defined(NETWORK_HAS_IPV6)
+        if(addressFamily == AddressFamily::IPv6)
+        {
+            // Windows takes a DWORD, Linux an int; both read four bytes.
+            uint32_t index = interfaceIndex;
+            if(!Platform::setOption(fd, IPPROTO_IPV6, IPV6_MULTICAST_IF, index)) return false;
+            multicastInterface4(fd, interfaceIndex);
+            return true;
+        }
+#endif
+        return multicastInterface4(fd, interfaceIndex);
+    }
+
+    bool UdpSocket::setMulticastHops(int hops) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+#if defined(IP_MULTICAST_TTL)
+        constexpr int V4 = IP_MULTICAST_TTL;
+#else
+        constexpr int V4 = -1;
+#endif
+#if defined(NETWORK_HAS_IPV6)
+        constexpr int V6 = IPV6_MULTICAST_HOPS;
+#else
+        constexpr int V6 = -1;
+#endif
+        return multicastOption(fd, addressFamily, V4, V6, hops);
+    }
+
+    bool UdpSocket::setMulticastLoopback(bool enabled) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+#if defined(IP_MULTICAST_LOOP)
+        constexpr int V4 = IP_MULTICAST_LOOP;
+#else
+        constexpr int V4 = -1;
+#endif
+#if defined(NETWORK_HAS_IPV6)
+        constexpr int V6 = IPV6_MULTICAST_LOOP;
+#else
+        constexpr int V6 = -1;
+#endif
+        return multicastOption(fd, addressFamily, V4, V6, enabled ? 1 : 0);
+    }
+
+    bool UdpSocket::membership(Endpoint const & group, Endpoint const * source, uint32_t interfaceIndex, bool join) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+        int level;
+        switch(group.family())
+        {
+        case AddressFamily::IPv4:
+            level = IPPROTO_IP;
+            break;
+#if defined(NETWORK_HAS_IPV6)
+        case AddressFamily::IPv6:
+            level = IPPROTO_IPV6;
+            if(interfaceIndex == 0) interfaceIndex = group.scopeId();
+            break;
+#endif
+        default:
+            Platform::setLastError(Platform::FamilyUnsupported);
+            return false;
+        }
+
+#if defined(MCAST_JOIN_GROUP)
+        // The protocol independent options (RFC 3678) take a plain sockaddr of the
+        // group's own family, v4-mapped forms are rejected.
+        SocketAddress groupAddr;
+        toSocketAddress(group, groupAddr);
+
+        if(source == nullptr)
+        {
+            group_req req{};
+            req.gr_interface = interfaceIndex;
+            std::memcpy(&req.gr_group, groupAddr.data(), groupAddr.length);
+            return Platform::setOption(fd, level, join ? MCAST_JOIN_GROUP : MCAST_LEAVE_GROUP, req);
+        }
+
+        SocketAddress sourceAddr;
+        if(!toSocketAddress(*source, sourceAddr))
+        {
+            Platform::setLastError(Platform::FamilyUnsupported);
+            return false;
+        }
+
+        group_source_req req{};
+        req.gsr_interface = interfaceIndex;
+        std::memcpy(&req.gsr_group, groupAddr.data(), groupAddr.length);
+        std::memcpy(&req.gsr_source, sourceAddr.data(), sourceAddr.length);
+        return Platform::setOption(fd, level, join ? MCAST_JOIN_SOURCE_GROUP : MCAST_LEAVE_SOURCE_GROUP, req);
+#elif defined(IP_ADD_MEMBERSHIP)
+        // Stacks without them only know any-source IPv4 membership on the default interface.
+        if(source != nullptr || level != IPPROTO_IP || interfaceIndex != 0)
+        {
+            Platform::setLastError(Platform::OptionUnsupported);
+            return false;
+        }
+
+        ip_mreq req{};
+        std::memcpy(&req.imr_multiaddr, group.bytes().data(), 4);
+        req.imr_interface.s_addr = htonl(INADDR_ANY);
+        return Platform::setOption(fd, IPPROTO_IP, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP, req);
+#else
+        (void)source;
+        (void)level;
+        (void)join;
+        Platform::setLastError(Platform::OptionUnsupported);
+        return false;
+#endif
     }
 
     bool UdpSocket::waitRead(int timeoutMs) noexcept
     {
-        if(fd < 0) return false;
+        if(!Platform::valid(fd)) return false;
 
-        pollfd pfd{};
+        Platform::PollDescriptor pfd{};
         pfd.fd = fd;
         pfd.events = POLLIN;
 
-        int ret = poll(&pfd, 1, timeoutMs);
+        int ret = Platform::poll(&pfd, 1, timeoutMs);
         if(ret < 0) return false;
         return (ret > 0 && (pfd.revents & POLLIN));
     }
 
     bool UdpSocket::waitWrite(int timeoutMs) noexcept
     {
-        if(fd < 0) return false;
+        if(!Platform::valid(fd)) return false;
 
-        pollfd pfd{};
+        Platform::PollDescriptor pfd{};
         pfd.fd = fd;
         pfd.events = POLLOUT;
 
-        int ret = poll(&pfd, 1, timeoutMs);
+        int ret = Platform::poll(&pfd, 1, timeoutMs);
         if(ret < 0) return false;
         return (ret > 0 && (pfd.revents & POLLOUT));
     }
 
     void UdpSocket::shutdown()
     {
-        if(fd < 0) return;
+        if(!Platform::valid(fd)) return;
+
+        ::shutdown(fd, Platform::ShutdownBoth);
+        Platform::close(fd);
+        fd = Platform::Invalid;
+    }
+
+    bool UdpSocket::setOptions(SocketOptions const & options) noexcept
+    {
+        if(!Platform::valid(fd)) return false;
+
+        return options.apply(fd);
+    }
+
+    SocketOptions UdpSocket::options() const noexcept
+    {
+        if(!Platform::valid(fd)) return SocketOptions();
 
-        ::shutdown(fd, SHUT_RDWR);
-        ::close(fd);
-        fd = -1;
+        return SocketOptions::query(fd);
+    }
+
+    Endpoint UdpSocket::localEndpoint() const noexcept
+    {
+        if(!Platform::valid(fd)) return Endpoint();
+
+        return Network::localEndpoint(fd);
+    }
+
+    AddressFamily UdpSocket::family() const noexcept
+    {
+        return addressFamily;
+    }
+
+    SocketFD UdpSocket::native() const noexcept
+    {
+        return fd;
     }
 }
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include "Network/ZeroCopySender.hpp"
+#include "Network/Platform.hpp"
+#include "Network/Probe.hpp"
+
+#if defined(__linux__) && defined(SO_ZEROCOPY)
+#include <linux/errqueue.h>
+#define NETWORK_HAS_ZEROCOPY 1
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace Library::Network
+{
+    ZeroCopySender::ZeroCopySender(TcpSocket socket) : ZeroCopySender(std::move(socket), Config{})
+    {
+    }
+
+    ZeroCopySender::ZeroCopySender(TcpSocket socket, Config config) :
+        stream(std::move(socket)),
+        config(config),
+        zeroCopy(false),
+        ring(std::max<size_t>(config.maxPending, 1)),
+        head(0),
+        count(0),
+        nextId(0),
+        copied(0)
+    {
+#if defined(NETWORK_HAS_ZEROCOPY)
+        int opt = 1;
+        zeroCopy = Platform::valid(stream.native()) && Platform::setOption(stream.native(), SOL_SOCKET, SO_ZEROCOPY, opt);
+#endif
+    }
+
+    ZeroCopySender::~ZeroCopySender() noexcept
+    {
+        releaseAll();
+    }
+
+    ZeroCopySender::ZeroCopySender(ZeroCopySender&& other) noexcept :
+        stream(std::move(other.stream)),
+        config(other.config),
+        zeroCopy(other.zeroCopy),
+        ring(std::move(other.ring)),
+        head(other.head),
+        count(other.count),
+        nextId(other.nextId),
+        copied(other.copied)
+    {
+        other.head = other.count = 0;
+        other.zeroCopy = false;
+    }
+
+    ZeroCopySender& ZeroCopySender::operator=(ZeroCopySender&& other) noexcept
+    {
+        if(this != &other)
+        {
+            releaseAll();
+
+            stream = std::move(other.stream);
+            config = other.config;
+            zeroCopy = other.zeroCopy;
+            ring = std::move(other.ring);
+            head = other.head;
+            count = other.count;
+            nextId = other.nextId;
+            copied = other.copied;
+
+            other.head = other.count = 0;
+            other.zeroCopy = false;
+        }
+        return *this;
+    }
+
+    TcpSocket& ZeroCopySender::socket() noexcept
+    {
+        return stream;
+    }
+
+    Result ZeroCopySender::send(void const * data, size_t size, Release release) noexcept
+    {
+        return transmit(data, size, release, nullptr);
+    }
+
+    Result ZeroCopySender::send(Buffer const & buffer) noexcept
+    {
+        Release none;
+        return transmit(buffer.data(), buffer.size(), none, &buffer);
+    }
+
+    Result ZeroCopySender::transmit(void const * data, size_t size, Release& release, Buffer const * buffer) noexcept
+    {
+        if(!Platform::valid(stream.native())) return {ResultType::Error, 0};
+        if(size == 0) return {ResultType::Data, 0};
+
+        // A copied send with a release waits behind pending zero-copy sends, which
+        // may still pin pages of the same payload.
+        bool pinned = zeroCopy && size >= config.threshold;
+        bool queued = pinned || (count > 0 && release);
+        if(queued && count == ring.size())
+        {
+            reap();
+            if(count == ring.size()) return {ResultType::WouldBlock, 0};
+        }
+
+#if defined(NETWORK_HAS_ZEROCOPY)
+        if(pinned)
+        {
+            Probe probe(Metric::TcpSend);
+            ptrdiff_t res = Platform::send(stream.native(), data, size, MSG_ZEROCOPY);
+            probe.done(res);
+            if(res < 0)
+            {
+                // ENOBUFS: no option memory left for another notification; copy instead.
+                int error = Platform::lastError();
+                if(error != ENOBUFS)
+                {
+                    if(Platform::wouldBlock(error)) return {ResultType::WouldBlock, 0};
+                    return {ResultType::Error, 0};
+                }
+                pinned = false;
+            }
+            else if(res == 0)
+            {
+                return {ResultType::Disconnected, 0};
+            }
+            else
+            {
+                Pending& pending = ring[(head + count) % ring.size()];
+                pending.release = std::move(release);
+                if(buffer != nullptr) pending.buffer = *buffer;
+                pending.id = nextId++;
+                pending.zeroCopy = true;
+                pending.done = false;
+                ++count;
+                return {ResultType::Data, static_cast<size_t>(res)};
+            }
+        }
+#else
+        (void)buffer;
+#endif
+
+        Result res = stream.send(data, size);
+        if(res.type != ResultType::Data || res.bytes == 0 || !release) return res;
+
+        if(count == 0)
+        {
+            release();
+            return res;
+        }
+
+        // Done already, released by releaseDone once everything before it is.
+        Pending& pending = ring[(head + count) % ring.size()];
+        pending.release = std::move(release);
+        pending.zeroCopy = false;
+        pending.done = true;
+        ++count;
+        return res;
+    }
+
+    size_t ZeroCopySender::reap() noexcept
+    {
+#if defined(NETWORK_HAS_ZEROCOPY)
+        if(count == 0 || !Platform::valid(stream.native())) return 0;
+
+        // One notification per read, each covering a range of send ids.
+        while(true)
+        {
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            msghdr msg{};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            if(::recvmsg(stream.native(), &msg, MSG_ERRQUEUE) < 0) break;
+
+            for(cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+            {
+                bool recvErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                               (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+                if(!recvErr) continue;
+
+                sock_extended_err err;
+                std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+                if(err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+
+                complete(err.ee_info, err.ee_data, (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+            }
+        }
+
+        return releaseDone();
+#else
+        return 0;
+#endif
+    }
+
+    bool ZeroCopySender::waitCompletions(int timeoutMs) noexcept
+    {
+        return await(timeoutMs) == Wake::Completions;
+    }
+
+    ZeroCopySender::Wake ZeroCopySender::await(int timeoutMs) noexcept
+    {
+        if(!Platform::valid(stream.native())) return Wake::Failed;
+
+        // The error queue has no event of its own; POLLERR is reported regardless.
+        Platform::PollDescriptor pfd{};
+        pfd.fd = stream.native();
+        pfd.events = 0;
+
+        int ret = Platform::poll(&pfd, 1, timeoutMs);
+        if(ret < 0) return Platform::interrupted(Platform::lastError()) ? Wake::Timeout : Wake::Failed;
+        if(ret == 0) return Wake::Timeout;
+
+        if(pfd.revents & POLLERR)
+        {
+            // A pending socket error raises POLLERR as well, and reading the error
+            // queue never clears it: take it, or every later poll returns at once.
+            int error = 0;
+            if(!Platform::getOption(stream.native(), SOL_SOCKET, SO_ERROR, error)) return Wake::Failed;
+            if(error == 0) return Wake::Completions;
+
+            Platform::setLastError(error);
+            return Wake::Failed;
+        }
+
+        // POLLHUP and POLLNVAL are reported without being asked for, so poll can't
+        // wait here any more.
+        return Wake::Failed;
+    }
+
+    bool ZeroCopySender::drain(int timeoutMs) noexcept
+    {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+        while(true)
+        {
+            reap();
+            if(count == 0) return true;
+
+            int wait = -1;
+            if(timeoutMs >= 0)
+            {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                if(left <= 0) return false;
+                wait = static_cast<int>(left);
+            }
+
+            if(await(wait) == Wake::Failed)
+            {
+                reap();
+                return count == 0;
+            }
+        }
+    }
+
+    size_t ZeroCopySender::pending() const noexcept
+    {
+        return count;
+    }
+
+    bool ZeroCopySender::enabled() const noexcept
+    {
+        return zeroCopy;
+    }
+
+    uint64_t ZeroCopySender::copiedSends() const noexcept
+    {
+        return copied;
+    }
+
+    void ZeroCopySender::complete(uint32_t first, uint32_t last, bool copiedByKernel) noexcept
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            Pending& pending = ring[(head + i) % ring.size()];
+            if(!pending.zeroCopy || pending.done) continue;
+
+            // Ids wrap at 2^32, so the range test is done on differences.
+            if(pending.id - first <= last - first)
+            {
+                pending.done = true;
+                if(copiedByKernel) ++copied;
+            }
+        }
+    }
+
+    size_t ZeroCopySender::releaseDone() noexcept
+    {
+        size_t released = 0;
+        while(count > 0 && ring[head].done)
+        {
+            Pending& pending = ring[head];
+            Release release = std::move(pending.release);
+            pending.release = nullptr;
+            pending.buffer.reset();
+            pending.done = false;
+
+            head = (head + 1) % ring.size();
+            --count;
+            ++released;
+
+            // Last, so a release that sends again sees a consistent ring.
+            if(release) release();
+        }
+        return released;
+    }
+
+    void ZeroCopySender::releaseAll() noexcept
+    {
+        for(; count > 0; --count)
+        {
+            Pending& pending = ring[head];
+            head = (head + 1) % ring.size();
+            if(pending.release) pending.release();
+            pending.release = nullptr;
+            pending.buffer.reset();
+        }
+    }
+}
\ No newline at end of file